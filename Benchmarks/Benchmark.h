@@ -0,0 +1,75 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <Objectively.h>
+
+/**
+ * @file
+ * @brief Helpers for the Objectively benchmarks.
+ */
+
+/**
+ * @return The current monotonic time, in seconds.
+ */
+static inline double BenchmarkTime(void) {
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @return The iteration count from the command line, or `iterations`.
+ */
+static inline size_t BenchmarkIterations(int argc, char **argv, size_t iterations) {
+
+	if (argc > 1) {
+		return strtoul(argv[1], NULL, 10);
+	}
+
+	return iterations;
+}
+
+/**
+ * @brief Times `statements` and prints the elapsed time and the time per operation.
+ * @param name The name of the benchmark.
+ * @param operations The number of operations performed by `statements`.
+ * @param statements The statements to time.
+ */
+#define Benchmark(name, operations, statements) \
+	({ \
+		const double _start = BenchmarkTime(); \
+		statements; \
+		const double _elapsed = BenchmarkTime() - _start; \
+		printf("%-40s %12zu ops %10.3f ms %10.2f ns/op\n", \
+			name, (size_t) (operations), _elapsed * 1e3, _elapsed * 1e9 / (operations)); \
+		_elapsed; \
+	})
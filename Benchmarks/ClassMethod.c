@@ -0,0 +1,70 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Benchmark.h"
+
+static size_t iterations;
+
+int main(int argc, char **argv) {
+
+	iterations = BenchmarkIterations(argc, argv, 100000000);
+
+	Object *object = $(alloc(Object), init);
+	ident volatile sink;
+
+	Benchmark("_Object()", iterations, {
+		for (size_t i = 0; i < iterations; i++) {
+			sink = _Object();
+		}
+	});
+
+	Benchmark("cast(Object, ...)", iterations, {
+		for (size_t i = 0; i < iterations; i++) {
+			sink = cast(Object, object);
+		}
+	});
+
+	Benchmark("$$(Boole, True)", iterations, {
+		for (size_t i = 0; i < iterations; i++) {
+			sink = $$(Boole, True);
+		}
+	});
+
+	Benchmark("$$(Null, null)", iterations, {
+		for (size_t i = 0; i < iterations; i++) {
+			sink = $$(Null, null);
+		}
+	});
+
+	Benchmark("$$(Number, numberWithValue, ...)", iterations, {
+		for (size_t i = 0; i < iterations; i++) {
+			sink = $$(Number, numberWithValue, i & 0xff);
+		}
+	});
+
+	(void) sink;
+
+	release(object);
+
+	return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "Benchmark.h"
+
+#define KEYS 65536
+
+static size_t iterations;
+
+static Number *keys[KEYS];
+
+static ConcurrentDictionary *concurrent;
+
+static MutableDictionary *locked;
+static Lock *lock;
+
+/**
+ * @brief Reads from, and every eighth operation writes to, the ConcurrentDictionary.
+ */
+static ident concurrentThread(ident data) {
+
+	unsigned seed = (unsigned) (uintptr_t) data;
+
+	for (size_t i = 0; i < iterations; i++) {
+
+		Number *key = keys[rand_r(&seed) % KEYS];
+
+		if ((i & 7) == 0) {
+			$(concurrent, setObjectForKey, key, key);
+		} else {
+			release($(concurrent, objectForKey, key));
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Reads from, and every eighth operation writes to, the Lock-guarded MutableDictionary.
+ */
+static ident lockedThread(ident data) {
+
+	unsigned seed = (unsigned) (uintptr_t) data;
+
+	for (size_t i = 0; i < iterations; i++) {
+
+		Number *key = keys[rand_r(&seed) % KEYS];
+
+		$(lock, lock);
+
+		if ((i & 7) == 0) {
+			$(locked, setObjectForKey, key, key);
+		} else {
+			$((Dictionary *) locked, objectForKey, key);
+		}
+
+		$(lock, unlock);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Runs `function` on `count` threads, each performing `iterations` operations.
+ */
+static void run(ident (*function)(ident), size_t count) {
+
+	pthread_t threads[count];
+
+	for (size_t i = 0; i < count; i++) {
+		pthread_create(&threads[i], NULL, function, (ident) (uintptr_t) (i + 1));
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		pthread_join(threads[i], NULL);
+	}
+}
+
+int main(int argc, char **argv) {
+
+	iterations = BenchmarkIterations(argc, argv, 1000000);
+
+	size_t processors = max(sysconf(_SC_NPROCESSORS_ONLN), 1L);
+	if (argc > 2) {
+		processors = strtoul(argv[2], NULL, 10);
+	}
+
+	concurrent = $(alloc(ConcurrentDictionary), init);
+
+	locked = $(alloc(MutableDictionary), init);
+	lock = $(alloc(Lock), init);
+
+	for (size_t i = 0; i < KEYS; i++) {
+		keys[i] = $(alloc(Number), initWithValue, i);
+
+		$(concurrent, setObjectForKey, keys[i], keys[i]);
+		$(locked, setObjectForKey, keys[i], keys[i]);
+	}
+
+	char name[64];
+
+	for (size_t threads = 1; threads <= processors; threads <<= 1) {
+
+		snprintf(name, sizeof(name), "ConcurrentDictionary (%zu threads)", threads);
+		Benchmark(name, iterations * threads, run(concurrentThread, threads));
+
+		snprintf(name, sizeof(name), "MutableDictionary + Lock (%zu threads)", threads);
+		Benchmark(name, iterations * threads, run(lockedThread, threads));
+	}
+
+	for (size_t i = 0; i < KEYS; i++) {
+		release(keys[i]);
+	}
+
+	release(concurrent);
+	release(locked);
+	release(lock);
+
+	return 0;
+}
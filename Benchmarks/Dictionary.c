@@ -0,0 +1,201 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Benchmark.h"
+
+static size_t iterations;
+
+static String **keys;
+static size_t count;
+
+/**
+ * @brief Inserts every key into the given MutableDictionary.
+ */
+static void insert(MutableDictionary *dictionary) {
+
+	for (size_t i = 0; i < count; i++) {
+		$(dictionary, setObjectForKey, keys[i], keys[i]);
+	}
+}
+
+/**
+ * @brief Looks up keys, round-robin, `iterations` times.
+ */
+static void lookup(const Dictionary *dictionary) {
+
+	size_t found = 0;
+
+	for (size_t i = 0; i < iterations; i++) {
+		if ($(dictionary, objectForKey, keys[i % count])) {
+			found++;
+		}
+	}
+
+	if (found != iterations) {
+		abort();
+	}
+}
+
+/**
+ * @brief Removes every key from the given MutableDictionary.
+ */
+static void removeAll(MutableDictionary *dictionary) {
+
+	for (size_t i = 0; i < count; i++) {
+		$(dictionary, removeObjectForKey, keys[i]);
+	}
+}
+
+/**
+ * @brief Inserts every key into a new MutableDictionary.
+ * @return The time taken by the slowest insertion, in seconds.
+ */
+static double slowestInsert(void) {
+
+	MutableDictionary *dictionary = $(alloc(MutableDictionary), init);
+
+	double slowest = 0.0;
+
+	for (size_t i = 0; i < count; i++) {
+
+		const double start = BenchmarkTime();
+
+		$(dictionary, setObjectForKey, keys[i], keys[i]);
+
+		slowest = max(slowest, BenchmarkTime() - start);
+	}
+
+	release(dictionary);
+
+	return slowest;
+}
+
+int main(int argc, char **argv) {
+
+	iterations = BenchmarkIterations(argc, argv, 10000000);
+
+	const size_t sizes[] = { 16, 1024, 65536, 1048576 };
+
+	for (size_t s = 0; s < lengthof(sizes); s++) {
+
+		count = sizes[s];
+
+		keys = calloc(count, sizeof(String *));
+		for (size_t i = 0; i < count; i++) {
+			keys[i] = $(alloc(String), initWithFormat, "key-%zu", i);
+		}
+
+		const size_t rounds = max((size_t) 1, iterations / count / 4);
+
+		char name[64];
+
+		MutableDictionary *dictionary = $(alloc(MutableDictionary), init);
+
+		snprintf(name, sizeof(name), "setObjectForKey (%zu keys)", count);
+		Benchmark(name, rounds * count, {
+			for (size_t r = 0; r < rounds; r++) {
+				insert(dictionary);
+				if (r < rounds - 1) {
+					$(dictionary, removeAllObjects);
+				}
+			}
+		});
+
+		snprintf(name, sizeof(name), "initWithObjectsForKeys (%zu keys)", count);
+		Benchmark(name, rounds * count, {
+			for (size_t r = 0; r < rounds; r++) {
+				release($((Dictionary *) alloc(Dictionary), initWithObjectsForKeysCount,
+						  (ident *) keys, (ident *) keys, count));
+			}
+		});
+
+		snprintf(name, sizeof(name), "objectForKey (%zu keys)", count);
+		Benchmark(name, iterations, lookup((Dictionary *) dictionary));
+
+		FrozenDictionary *frozen = $$(FrozenDictionary, dictionaryWithDictionary, (Dictionary *) dictionary);
+
+		snprintf(name, sizeof(name), "frozen objectForKey (%zu keys)", count);
+		Benchmark(name, iterations, lookup((Dictionary *) frozen));
+
+		release(frozen);
+
+		MutableDictionary *ordered = (MutableDictionary *) $(alloc(OrderedDictionary), init);
+
+		snprintf(name, sizeof(name), "ordered setObjectForKey (%zu keys)", count);
+		Benchmark(name, count, insert(ordered));
+
+		snprintf(name, sizeof(name), "ordered objectForKey (%zu keys)", count);
+		Benchmark(name, iterations, lookup((Dictionary *) ordered));
+
+		release(ordered);
+
+		snprintf(name, sizeof(name), "removeObjectForKey (%zu keys)", count);
+		Benchmark(name, rounds * count, {
+			for (size_t r = 0; r < rounds; r++) {
+				removeAll(dictionary);
+				if (r < rounds - 1) {
+					insert(dictionary);
+				}
+			}
+		});
+
+		release(dictionary);
+
+		snprintf(name, sizeof(name), "slowest setObjectForKey (%zu keys)", count);
+		printf("%-40s %43.2f us\n", name, slowestInsert() * 1e6);
+
+		for (size_t i = 0; i < count; i++) {
+			release(keys[i]);
+		}
+		free(keys);
+	}
+
+	const size_t lengths[] = { 64, 256, 1024 };
+
+	for (size_t l = 0; l < lengthof(lengths); l++) {
+
+		count = 1024;
+
+		keys = calloc(count, sizeof(String *));
+		for (size_t i = 0; i < count; i++) {
+			keys[i] = $(alloc(String), initWithFormat, "%0*zu", (int) lengths[l], i);
+		}
+
+		MutableDictionary *dictionary = $(alloc(MutableDictionary), init);
+		insert(dictionary);
+
+		char name[64];
+
+		snprintf(name, sizeof(name), "objectForKey (%zu byte keys)", lengths[l]);
+		Benchmark(name, iterations, lookup((Dictionary *) dictionary));
+
+		release(dictionary);
+
+		for (size_t i = 0; i < count; i++) {
+			release(keys[i]);
+		}
+		free(keys);
+	}
+
+	return 0;
+}
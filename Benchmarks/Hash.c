@@ -0,0 +1,88 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Benchmark.h"
+
+static size_t iterations;
+
+static volatile int sink;
+
+/**
+ * @brief Hashes `length` bytes of the given buffer `count` times.
+ */
+static void hashBytes(const uint8_t *bytes, size_t length, size_t count) {
+
+	const Range range = { 0, length };
+
+	for (size_t i = 0; i < count; i++) {
+		sink = HashForBytes(HASH_SEED, bytes, range);
+	}
+}
+
+/**
+ * @brief Hashes the given Strings repeatedly.
+ */
+static void hashStrings(String **strings, size_t count) {
+
+	for (size_t i = 0; i < iterations; i++) {
+		sink = $((Object *) strings[i % count], hash);
+	}
+}
+
+int main(int argc, char **argv) {
+
+	iterations = BenchmarkIterations(argc, argv, 10000000);
+
+	uint8_t *bytes = malloc(4096);
+	for (size_t i = 0; i < 4096; i++) {
+		bytes[i] = (uint8_t) rand();
+	}
+
+	const size_t lengths[] = { 8, 16, 32, 64, 256, 1024, 4096 };
+
+	for (size_t i = 0; i < lengthof(lengths); i++) {
+
+		const size_t count = iterations * 16 / lengths[i];
+
+		char name[64];
+		snprintf(name, sizeof(name), "HashForBytes (%zu bytes)", lengths[i]);
+
+		const double elapsed = Benchmark(name, count, hashBytes(bytes, lengths[i], count));
+		printf("%-40s %12.1f MB/s\n", "", count * lengths[i] / elapsed / 1e6);
+	}
+
+	String *strings[1024];
+	for (size_t i = 0; i < lengthof(strings); i++) {
+		strings[i] = $(alloc(String), initWithFormat, "key-%zu", i);
+	}
+
+	Benchmark("String::hash (short)", iterations, hashStrings(strings, lengthof(strings)));
+
+	for (size_t i = 0; i < lengthof(strings); i++) {
+		release(strings[i]);
+	}
+
+	free(bytes);
+
+	return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Benchmark.h"
+
+static size_t iterations;
+
+/**
+ * @brief Appends `count` Objects to the given MutableArray.
+ */
+static void append(MutableArray *array, Object *object, size_t count) {
+
+	for (size_t i = 0; i < count; i++) {
+		$(array, addObject, object);
+	}
+}
+
+/**
+ * @brief Inserts `iterations` Objects at the front of the given MutableArray.
+ */
+static void insertFront(MutableArray *array, Object *object) {
+
+	for (size_t i = 0; i < iterations; i++) {
+		$(array, insertObjectAtIndex, object, 0);
+	}
+}
+
+/**
+ * @brief Removes `iterations` Objects from the middle of the given MutableArray.
+ */
+static void removeMiddle(MutableArray *array) {
+
+	for (size_t i = 0; i < iterations; i++) {
+		$(array, removeObjectAtIndex, ((Array *) array)->count >> 1);
+	}
+}
+
+/**
+ * @brief Tests `iterations` Numbers from the back of the given Array for membership.
+ */
+static void contains(const Array *array) {
+
+	for (size_t i = 0; i < iterations; i++) {
+
+		Number *number = $$(Number, numberWithValue, array->count - 1 - i % array->count);
+
+		if ($(array, containsObject, number) == false) {
+			abort();
+		}
+
+		release(number);
+	}
+}
+
+/**
+ * @brief A Predicate which retains every other Object.
+ */
+static _Bool alternate(const ident obj, ident data) {
+	return (*(size_t *) data)++ & 1;
+}
+
+int main(int argc, char **argv) {
+
+	iterations = BenchmarkIterations(argc, argv, 1000);
+
+	Object *object = $(alloc(Object), init);
+
+	for (size_t count = 1000; count <= 10000000; count *= 10) {
+
+		char name[64];
+
+		MutableArray *array = $(alloc(MutableArray), init);
+
+		snprintf(name, sizeof(name), "append (%zu elements)", count);
+		Benchmark(name, count, append(array, object, count));
+
+		snprintf(name, sizeof(name), "insert front (%zu elements)", count);
+		Benchmark(name, iterations, insertFront(array, object));
+
+		snprintf(name, sizeof(name), "remove middle (%zu elements)", count);
+		Benchmark(name, iterations, removeMiddle(array));
+
+		size_t index = 0;
+
+		snprintf(name, sizeof(name), "filter (%zu elements)", count);
+		Benchmark(name, count, $(array, filter, alternate, &index));
+
+		release(array);
+	}
+
+	release(object);
+
+	for (size_t count = 1000; count <= 100000; count *= 10) {
+
+		char name[64];
+
+		MutableArray *array = $(alloc(MutableArray), initWithCapacity, count);
+		MutableArray *indexedArray = (MutableArray *) $(alloc(IndexedArray), initWithCapacity, count);
+
+		for (size_t i = 0; i < count; i++) {
+
+			Number *number = $$(Number, numberWithValue, i);
+
+			$(array, addObject, number);
+			$(indexedArray, addObject, number);
+
+			release(number);
+		}
+
+		snprintf(name, sizeof(name), "contains (%zu elements)", count);
+		Benchmark(name, iterations, contains((Array *) array));
+
+		snprintf(name, sizeof(name), "contains, indexed (%zu elements)", count);
+		Benchmark(name, iterations, contains((Array *) indexedArray));
+
+		release(array);
+		release(indexedArray);
+	}
+
+	return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Benchmark.h"
+
+static size_t iterations;
+
+static String **keys;
+static size_t count;
+
+/**
+ * @brief Publishes `iterations` snapshots of a MutableDictionary, each differing by one key.
+ */
+static void mutableSnapshots(const Dictionary *dictionary) {
+
+	for (size_t i = 0; i < iterations; i++) {
+
+		MutableDictionary *next = $(dictionary, mutableCopy);
+		$(next, setObjectForKey, keys[i % count], keys[(i + 1) % count]);
+
+		Dictionary *snapshot = (Dictionary *) $((Object *) next, copy);
+
+		release(next);
+		release(snapshot);
+	}
+}
+
+/**
+ * @brief Publishes `iterations` snapshots of a PersistentDictionary, each differing by one key.
+ */
+static void persistentSnapshots(const PersistentDictionary *dictionary) {
+
+	for (size_t i = 0; i < iterations; i++) {
+
+		PersistentDictionary *snapshot = $(dictionary, dictionaryBySettingObjectForKey,
+										   keys[i % count], keys[(i + 1) % count]);
+		release(snapshot);
+	}
+}
+
+/**
+ * @brief Looks up keys, round-robin, `lookups` times.
+ */
+static void lookup(const Dictionary *dictionary, size_t lookups) {
+
+	size_t found = 0;
+
+	for (size_t i = 0; i < lookups; i++) {
+		if ($(dictionary, objectForKey, keys[i % count])) {
+			found++;
+		}
+	}
+
+	if (found != lookups) {
+		abort();
+	}
+}
+
+int main(int argc, char **argv) {
+
+	iterations = BenchmarkIterations(argc, argv, 100);
+
+	const size_t sizes[] = { 1024, 65536 };
+
+	for (size_t s = 0; s < lengthof(sizes); s++) {
+
+		count = sizes[s];
+
+		keys = calloc(count, sizeof(String *));
+
+		MutableDictionary *mutable = $(alloc(MutableDictionary), init);
+
+		for (size_t i = 0; i < count; i++) {
+			keys[i] = $(alloc(String), initWithFormat, "key-%zu", i);
+			$(mutable, setObjectForKey, keys[i], keys[i]);
+		}
+
+		PersistentDictionary *persistent = (PersistentDictionary *) $((Dictionary *) alloc(PersistentDictionary),
+				initWithDictionary, (Dictionary *) mutable);
+
+		char name[64];
+
+		snprintf(name, sizeof(name), "mutable snapshot (%zu keys)", count);
+		Benchmark(name, iterations, mutableSnapshots((Dictionary *) mutable));
+
+		snprintf(name, sizeof(name), "persistent snapshot (%zu keys)", count);
+		Benchmark(name, iterations, persistentSnapshots(persistent));
+
+		const size_t lookups = iterations * 10000;
+
+		snprintf(name, sizeof(name), "objectForKey (%zu keys)", count);
+		Benchmark(name, lookups, lookup((Dictionary *) mutable, lookups));
+
+		snprintf(name, sizeof(name), "persistent objectForKey (%zu keys)", count);
+		Benchmark(name, lookups, lookup((Dictionary *) persistent, lookups));
+
+		release(persistent);
+		release(mutable);
+
+		for (size_t i = 0; i < count; i++) {
+			release(keys[i]);
+		}
+		free(keys);
+	}
+
+	return 0;
+}
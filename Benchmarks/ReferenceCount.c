@@ -0,0 +1,87 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <pthread.h>
+
+#include "Benchmark.h"
+
+static size_t iterations;
+
+/**
+ * @brief Retains and releases the given Object repeatedly.
+ */
+static void retainRelease(Object *object) {
+
+	for (size_t i = 0; i < iterations; i++) {
+		release(retain(object));
+	}
+}
+
+/**
+ * @brief Builds and tears down a MutableArray of the given Objects.
+ */
+static void buildTeardown(Object **objects, size_t count) {
+
+	for (size_t i = 0; i < iterations; i += count) {
+
+		MutableArray *array = $(alloc(MutableArray), initWithCapacity, count);
+
+		for (size_t j = 0; j < count; j++) {
+			$(array, addObject, objects[j]);
+		}
+
+		release(array);
+	}
+}
+
+static Object *objects[1024];
+
+static ident foreignThread(ident data) {
+
+	Benchmark("retain / release (foreign)", iterations, retainRelease(objects[0]));
+	Benchmark("MutableArray build / teardown (foreign)", iterations, buildTeardown(objects, lengthof(objects)));
+
+	return NULL;
+}
+
+int main(int argc, char **argv) {
+
+	iterations = BenchmarkIterations(argc, argv, 10000000);
+
+	for (size_t i = 0; i < lengthof(objects); i++) {
+		objects[i] = $(alloc(Object), init);
+	}
+
+	Benchmark("retain / release (owner)", iterations, retainRelease(objects[0]));
+	Benchmark("MutableArray build / teardown (owner)", iterations, buildTeardown(objects, lengthof(objects)));
+
+	pthread_t thread;
+	pthread_create(&thread, NULL, foreignThread, NULL);
+	pthread_join(thread, NULL);
+
+	for (size_t i = 0; i < lengthof(objects); i++) {
+		release(objects[i]);
+	}
+
+	return 0;
+}
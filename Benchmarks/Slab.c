@@ -0,0 +1,161 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <pthread.h>
+
+#include "Benchmark.h"
+
+/**
+ * @brief A small type, comparable in size to Number or String.
+ */
+typedef struct {
+	Object object;
+	ObjectInterface *interface;
+	double payload[2];
+} Small;
+
+/**
+ * @brief The Small Class, allocated with `calloc`.
+ */
+static Class *_Calloc(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "Calloc";
+		clazz.superclass = _Object();
+		clazz.instanceSize = sizeof(Small);
+		clazz.interfaceOffset = offsetof(Small, interface);
+		clazz.interfaceSize = sizeof(ObjectInterface);
+	});
+
+	return &clazz;
+}
+
+/**
+ * @brief The Small Class, allocated from a Slab.
+ */
+static Class *_Slabbed(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "Slabbed";
+		clazz.superclass = _Object();
+		clazz.instanceSize = sizeof(Small);
+		clazz.interfaceOffset = offsetof(Small, interface);
+		clazz.interfaceSize = sizeof(ObjectInterface);
+	});
+
+	return &clazz;
+}
+
+static size_t iterations;
+
+/**
+ * @brief Allocates and releases batches of instances of the given Class.
+ */
+static void churn(Class *clazz) {
+
+	Object *objects[256];
+
+	for (size_t i = 0; i < iterations; i += lengthof(objects)) {
+		for (size_t j = 0; j < lengthof(objects); j++) {
+			objects[j] = _alloc(clazz);
+		}
+		for (size_t j = 0; j < lengthof(objects); j++) {
+			release(objects[j]);
+		}
+	}
+}
+
+static ident churnThread(ident clazz) {
+
+	churn((Class *) clazz);
+
+	return NULL;
+}
+
+/**
+ * @brief Runs `churn` on `count` threads concurrently.
+ */
+static void churnThreads(Class *clazz, size_t count) {
+
+	pthread_t threads[count];
+
+	for (size_t i = 0; i < count; i++) {
+		pthread_create(&threads[i], NULL, churnThread, clazz);
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		pthread_join(threads[i], NULL);
+	}
+}
+
+int main(int argc, char **argv) {
+
+	iterations = BenchmarkIterations(argc, argv, 10000000);
+
+	_slabAllocation = false;
+	_initialize(_Calloc());
+
+	_slabAllocation = true;
+	_initialize(_Slabbed());
+
+	ident blocks[256];
+
+	Benchmark("calloc / free", iterations, {
+		for (size_t i = 0; i < iterations; i += lengthof(blocks)) {
+			for (size_t j = 0; j < lengthof(blocks); j++) {
+				blocks[j] = calloc(1, sizeof(Small));
+			}
+			for (size_t j = 0; j < lengthof(blocks); j++) {
+				free(blocks[j]);
+			}
+		}
+	});
+
+	Slab *slab = SlabCreate(sizeof(Small));
+
+	Benchmark("SlabAllocate / SlabFree", iterations, {
+		for (size_t i = 0; i < iterations; i += lengthof(blocks)) {
+			for (size_t j = 0; j < lengthof(blocks); j++) {
+				blocks[j] = SlabAllocate(slab);
+			}
+			for (size_t j = 0; j < lengthof(blocks); j++) {
+				SlabFree(slab, blocks[j]);
+			}
+		}
+	});
+
+	SlabDestroy(slab);
+
+	Benchmark("_alloc / release (calloc)", iterations, churn(_Calloc()));
+	Benchmark("_alloc / release (slab)", iterations, churn(_Slabbed()));
+
+	Benchmark("_alloc / release (calloc, 4 threads)", iterations * 4, churnThreads(_Calloc(), 4));
+	Benchmark("_alloc / release (slab, 4 threads)", iterations * 4, churnThreads(_Slabbed(), 4));
+
+	return 0;
+}
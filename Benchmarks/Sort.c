@@ -0,0 +1,74 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Benchmark.h"
+
+/**
+ * @brief The Comparator for the benchmarks.
+ */
+static Order compareNumbers(const ident obj1, const ident obj2) {
+	return $((Number *) obj1, compareTo, (Number *) obj2);
+}
+
+int main(int argc, char **argv) {
+
+	const size_t limit = BenchmarkIterations(argc, argv, 10000000);
+
+	for (size_t count = 1000000; count <= limit; count *= 10) {
+
+		MutableArray *array = $(alloc(MutableArray), initWithCapacity, count);
+
+		for (size_t i = 0; i < count; i++) {
+
+			Number *number = $(alloc(Number), initWithValue, rand() / (double) RAND_MAX);
+
+			$(array, addObject, number);
+
+			release(number);
+		}
+
+		char name[64];
+
+		MutableArray *copy = (MutableArray *) $((Object *) array, copy);
+
+		snprintf(name, sizeof(name), "sort (%zu elements)", count);
+		Benchmark(name, count, $(copy, sort, compareNumbers));
+
+		release(copy);
+		copy = (MutableArray *) $((Object *) array, copy);
+
+		snprintf(name, sizeof(name), "sortStable (%zu elements)", count);
+		Benchmark(name, count, $(copy, sortStable, compareNumbers));
+
+		release(copy);
+		copy = (MutableArray *) $((Object *) array, copy);
+
+		snprintf(name, sizeof(name), "sortParallel (%zu elements)", count);
+		Benchmark(name, count, $(copy, sortParallel, compareNumbers, 0));
+
+		release(copy);
+		release(array);
+	}
+
+	return 0;
+}
@@ -0,0 +1,119 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <stdio.h>
+
+#include "Benchmark.h"
+
+/**
+ * @brief The depth of the hierarchy.
+ */
+#define DEPTH 16
+
+/**
+ * @brief A hierarchy of `DEPTH` Classes, each extending the last.
+ */
+static Class classes[DEPTH];
+
+static char names[DEPTH][16];
+
+/**
+ * @brief Defines and initializes the hierarchy.
+ */
+static void defineClasses(void) {
+
+	for (size_t i = 0; i < DEPTH; i++) {
+
+		snprintf(names[i], sizeof(names[i]), "Deep%zu", i);
+
+		classes[i].name = names[i];
+		classes[i].superclass = i ? &classes[i - 1] : _Object();
+		classes[i].instanceSize = sizeof(Object);
+		classes[i].interfaceOffset = offsetof(Object, interface);
+		classes[i].interfaceSize = sizeof(ObjectInterface);
+	}
+
+	_initialize(&classes[DEPTH - 1]);
+}
+
+/**
+ * @brief The superclass chain walk that the ancestor display replaces.
+ */
+static _Bool isKindOfClassByWalking(const Object *obj, const Class *clazz) {
+
+	const Class *c = obj->clazz;
+	while (c) {
+		if (c == clazz) {
+			return true;
+		}
+		c = c->superclass;
+	}
+
+	return false;
+}
+
+int main(int argc, char **argv) {
+
+	const size_t iterations = BenchmarkIterations(argc, argv, 100000000);
+
+	defineClasses();
+
+	Object *obj = _alloc(&classes[DEPTH - 1]);
+
+	Class *targets[] = { _Object(), &classes[DEPTH / 2], &classes[DEPTH - 1], _String() };
+	const char *labels[] = { "root", "middle", "self", "miss" };
+
+	_initialize(_String());
+
+	volatile size_t hits = 0;
+
+	for (size_t i = 0; i < lengthof(targets); i++) {
+		Class *target = targets[i];
+		char name[64];
+
+		snprintf(name, sizeof(name), "walk (%s)", labels[i]);
+		Benchmark(name, iterations, {
+			for (size_t j = 0; j < iterations; j++) {
+				hits += isKindOfClassByWalking(obj, target);
+			}
+		});
+
+		snprintf(name, sizeof(name), "isKindOfClass (%s)", labels[i]);
+		Benchmark(name, iterations, {
+			for (size_t j = 0; j < iterations; j++) {
+				hits += $(obj, isKindOfClass, target);
+			}
+		});
+	}
+
+	Benchmark("cast (root)", iterations, {
+		for (size_t j = 0; j < iterations; j++) {
+			hits += cast(Object, obj) != NULL;
+		}
+	});
+
+	release(obj);
+
+	return 0;
+}
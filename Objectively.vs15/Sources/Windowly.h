@@ -67,6 +67,10 @@ char *asprintf(char ** __restrict ret, char * __restrict format, ...);
 #define __sync_val_compare_and_swap(c0, c1, c2) InterlockedCompareExchange((volatile long*)c0, c1, c2)
 #define __sync_add_and_fetch(c0, c1) InterlockedAdd((volatile long*)c0, c1)
 #define __sync_lock_test_and_set(c0, c1) InterlockedExchangePointer((PVOID volatile *)c0, (PVOID)c1)
+#define __sync_bool_compare_and_swap(c0, c1, c2) (InterlockedCompareExchangePointer((PVOID volatile *)c0, (PVOID)c2, (PVOID)c1) == (PVOID)c1)
+
+// BIT STUFF
+#define __builtin_popcount __popcnt
 
 // POSIX STUFF
 #define strdup _strdup
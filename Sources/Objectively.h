@@ -29,8 +29,10 @@
  */
 
 #include <Objectively/Array.h>
+#include <Objectively/AutoreleasePool.h>
 #include <Objectively/Boole.h>
 #include <Objectively/Class.h>
+#include <Objectively/ConcurrentDictionary.h>
 #include <Objectively/Condition.h>
 #include <Objectively/Config.h>
 #include <Objectively/Data.h>
@@ -39,7 +41,9 @@
 #include <Objectively/Dictionary.h>
 #include <Objectively/Enum.h>
 #include <Objectively/Error.h>
+#include <Objectively/FrozenDictionary.h>
 #include <Objectively/Hash.h>
+#include <Objectively/IndexedArray.h>
 #include <Objectively/IndexPath.h>
 #include <Objectively/IndexSet.h>
 #include <Objectively/JSONPath.h>
@@ -55,12 +59,16 @@
 #include <Objectively/Number.h>
 #include <Objectively/NumberFormatter.h>
 #include <Objectively/Object.h>
+#include <Objectively/Once.h>
 #include <Objectively/Operation.h>
 #include <Objectively/OperationQueue.h>
-#include <Objectively/Once.h>
+#include <Objectively/OrderedDictionary.h>
+#include <Objectively/PersistentDictionary.h>
 #include <Objectively/Regex.h>
 #include <Objectively/Resource.h>
 #include <Objectively/Set.h>
+#include <Objectively/Slab.h>
+#include <Objectively/SortedDictionary.h>
 #include <Objectively/String.h>
 #include <Objectively/Thread.h>
 #include <Objectively/Types.h>
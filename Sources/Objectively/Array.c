@@ -399,7 +399,7 @@ static Array *sortedArray(const Array *self, Comparator comparator) {
 
 	MutableArray *array = $(self, mutableCopy);
 
-	$(array, sort, comparator);
+	$(array, sortStable, comparator);
 
 	return (Array *) array;
 }
@@ -235,6 +235,7 @@ struct ArrayInterface {
 	 * @param self The Array.
 	 * @param comparator The Comparator
 	 * @return A copy of this Array, sorted by the given Comparator.
+	 * @remarks The sort is stable.
 	 * @memberof Array
 	 */
 	Array *(*sortedArray)(const Array *self, Comparator comparator);
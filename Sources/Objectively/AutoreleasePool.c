@@ -0,0 +1,196 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <Objectively/AutoreleasePool.h>
+
+#define _Class _AutoreleasePool
+
+#define AUTORELEASEPOOL_DEFAULT_CAPACITY 64
+
+static __thread AutoreleasePool *_currentPool;
+
+#pragma mark - Object
+
+/**
+ * @see Object::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+	return NULL;
+}
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	AutoreleasePool *this = (AutoreleasePool *) self;
+
+	$(this, drain);
+
+	assert(_currentPool == this);
+	_currentPool = this->parent;
+
+	free(this->objects);
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - AutoreleasePool
+
+/**
+ * @fn void AutoreleasePool::addObject(AutoreleasePool *self, ident obj)
+ * @memberof AutoreleasePool
+ */
+static void addObject(AutoreleasePool *self, ident obj) {
+
+	assert(obj);
+
+	if (self->count == self->capacity) {
+
+		self->capacity = self->capacity ? self->capacity * 2 : AUTORELEASEPOOL_DEFAULT_CAPACITY;
+
+		self->objects = realloc(self->objects, self->capacity * sizeof(ident));
+		assert(self->objects);
+	}
+
+	self->objects[self->count++] = obj;
+}
+
+/**
+ * @fn AutoreleasePool *AutoreleasePool::currentPool(void)
+ * @memberof AutoreleasePool
+ */
+static AutoreleasePool *currentPool(void) {
+
+	return _currentPool;
+}
+
+/**
+ * @brief qsort comparator, grouping Objects by Class, and then by address.
+ */
+static int drain_compare(const void *a, const void *b) {
+
+	const Object *objA = *(const Object **) a;
+	const Object *objB = *(const Object **) b;
+
+	if (objA->clazz != objB->clazz) {
+		return (uintptr_t) objA->clazz < (uintptr_t) objB->clazz ? -1 : 1;
+	}
+
+	if (objA != objB) {
+		return (uintptr_t) objA < (uintptr_t) objB ? -1 : 1;
+	}
+
+	return 0;
+}
+
+/**
+ * @fn void AutoreleasePool::drain(AutoreleasePool *self)
+ * @memberof AutoreleasePool
+ */
+static void drain(AutoreleasePool *self) {
+
+	while (self->count) {
+
+		ident *objects = self->objects;
+		const size_t count = self->count;
+		const size_t capacity = self->capacity;
+
+		self->objects = NULL;
+		self->count = self->capacity = 0;
+
+		qsort(objects, count, sizeof(ident), drain_compare);
+
+		for (size_t i = 0; i < count; i++) {
+			release(objects[i]);
+		}
+
+		if (self->objects == NULL) {
+			self->objects = objects;
+			self->capacity = capacity;
+		} else {
+			free(objects);
+		}
+	}
+}
+
+/**
+ * @fn AutoreleasePool *AutoreleasePool::init(AutoreleasePool *self)
+ * @memberof AutoreleasePool
+ */
+static AutoreleasePool *init(AutoreleasePool *self) {
+
+	self = (AutoreleasePool *) super(Object, self, init);
+	if (self) {
+		self->parent = _currentPool;
+		_currentPool = self;
+	}
+
+	return self;
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	ObjectInterface *object = (ObjectInterface *) clazz->def->interface;
+
+	object->copy = copy;
+	object->dealloc = dealloc;
+
+	AutoreleasePoolInterface *autoreleasePool = (AutoreleasePoolInterface *) clazz->def->interface;
+
+	autoreleasePool->addObject = addObject;
+	autoreleasePool->currentPool = currentPool;
+	autoreleasePool->drain = drain;
+	autoreleasePool->init = init;
+}
+
+/**
+ * @fn Class *AutoreleasePool::_AutoreleasePool(void)
+ * @memberof AutoreleasePool
+ */
+Class *_AutoreleasePool(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "AutoreleasePool";
+		clazz.superclass = _Object();
+		clazz.instanceSize = sizeof(AutoreleasePool);
+		clazz.interfaceOffset = offsetof(AutoreleasePool, interface);
+		clazz.interfaceSize = sizeof(AutoreleasePoolInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
@@ -0,0 +1,150 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#pragma once
+
+#include <Objectively/Object.h>
+
+/**
+ * @file
+ * @brief AutoreleasePools defer the release of Objects.
+ */
+
+typedef struct AutoreleasePool AutoreleasePool;
+typedef struct AutoreleasePoolInterface AutoreleasePoolInterface;
+
+/**
+ * @brief AutoreleasePools defer the release of Objects.
+ * @details Each thread maintains its own stack of AutoreleasePools. Initializing an AutoreleasePool
+ * pushes it onto the calling thread's stack, and deallocating it pops it. Objects passed to
+ * `autorelease` are added to the current AutoreleasePool, and released when it is drained.
+ * ```
+ * WithAutoreleasePool({
+ *     String *string = autorelease(str("Hello, %s", "world"));
+ *     ...
+ * });
+ * ```
+ * @remarks Pooled Objects are released in bulk, grouped by Class, when the pool is drained.
+ * @extends Object
+ * @ingroup Core
+ */
+struct AutoreleasePool {
+
+	/**
+	 * @brief The superclass.
+	 */
+	Object object;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	AutoreleasePoolInterface *interface;
+
+	/**
+	 * @brief The count of Objects awaiting release.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The capacity of `objects`.
+	 * @private
+	 */
+	size_t capacity;
+
+	/**
+	 * @brief The Objects awaiting release.
+	 * @private
+	 */
+	ident *objects;
+
+	/**
+	 * @brief The enclosing AutoreleasePool.
+	 * @private
+	 */
+	AutoreleasePool *parent;
+};
+
+/**
+ * @brief The AutoreleasePool interface.
+ */
+struct AutoreleasePoolInterface {
+
+	/**
+	 * @brief The superclass interface.
+	 */
+	ObjectInterface objectInterface;
+
+	/**
+	 * @fn void AutoreleasePool::addObject(AutoreleasePool *self, ident obj)
+	 * @brief Adds the given Object to this AutoreleasePool.
+	 * @param self The AutoreleasePool.
+	 * @param obj The Object to release when this AutoreleasePool is drained.
+	 * @memberof AutoreleasePool
+	 */
+	void (*addObject)(AutoreleasePool *self, ident obj);
+
+	/**
+	 * @static
+	 * @fn AutoreleasePool *AutoreleasePool::currentPool(void)
+	 * @return The current AutoreleasePool of the calling thread, or `NULL`.
+	 * @memberof AutoreleasePool
+	 */
+	AutoreleasePool *(*currentPool)(void);
+
+	/**
+	 * @fn void AutoreleasePool::drain(AutoreleasePool *self)
+	 * @brief Releases all Objects in this AutoreleasePool.
+	 * @param self The AutoreleasePool.
+	 * @remarks Objects autoreleased while draining are released as well.
+	 * @memberof AutoreleasePool
+	 */
+	void (*drain)(AutoreleasePool *self);
+
+	/**
+	 * @fn AutoreleasePool *AutoreleasePool::init(AutoreleasePool *self)
+	 * @brief Initializes this AutoreleasePool, making it the current AutoreleasePool.
+	 * @param self The AutoreleasePool.
+	 * @return The initialized AutoreleasePool, or `NULL` on error.
+	 * @memberof AutoreleasePool
+	 */
+	AutoreleasePool *(*init)(AutoreleasePool *self);
+};
+
+/**
+ * @fn Class *AutoreleasePool::_AutoreleasePool(void)
+ * @brief The AutoreleasePool archetype.
+ * @return The AutoreleasePool Class.
+ * @memberof AutoreleasePool
+ */
+OBJECTIVELY_EXPORT Class *_AutoreleasePool(void);
+
+/**
+ * @brief Executes `statements` within a new AutoreleasePool.
+ */
+#define WithAutoreleasePool(statements) { \
+	AutoreleasePool *_pool = $(alloc(AutoreleasePool), init); \
+		statements; \
+	release(_pool); \
+}
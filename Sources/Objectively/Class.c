@@ -24,20 +24,176 @@
 #include <Objectively/Config.h>
 
 #include <assert.h>
+#include <signal.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <pthread.h>
+
 #if HAVE_UNISTD_H
 #include <unistd.h>
 #endif
 
+#ifndef STDERR_FILENO
+#define STDERR_FILENO 2
+#endif
+
+#include <Objectively/AutoreleasePool.h>
 #include <Objectively/Class.h>
+#include <Objectively/Hash.h>
 #include <Objectively/Object.h>
 
 size_t _pageSize;
 
+_Bool _slabAllocation;
+
+_Bool _classStatistics;
+
 static ClassDef *_classes;
 
+static ClassDef *_registry[CLASS_REGISTRY_SIZE];
+
+/**
+ * @brief The shared reference count flag indicating that the owner's count has been merged.
+ */
+#define SHARED_MERGED 0x1
+
+/**
+ * @brief The shared reference count flag indicating that the Object is queued to its owner.
+ */
+#define SHARED_QUEUED 0x2
+
+/**
+ * @brief The shared reference count flag indicating that the Object is immortal.
+ */
+#define SHARED_IMMORTAL 0x4
+
+/**
+ * @brief The shared reference count flag indicating that the Object may be weakly referenced.
+ */
+#define SHARED_WEAK 0x8
+
+/**
+ * @brief The shared reference count increment, which sits above the flags.
+ */
+#define SHARED_ONE 0x10
+
+/**
+ * @return True if the given shared reference count indicates that the Object is being deallocated.
+ */
+#define SHARED_IS_DEAD(shared) (((shared) & ~SHARED_WEAK) == SHARED_MERGED)
+
+/**
+ * @brief The number of lock stripes in the weak reference table.
+ */
+#define WEAK_TABLE_STRIPES 64
+
+/**
+ * @brief Each thread that allocates Objects is their Owner.
+ * @details The Owner of an Object retains and releases it without atomic operations. When another
+ * thread drives an Object's shared reference count negative, the Object may be dead, but only the
+ * Owner knows. Such Objects are queued to the Owner, which merges their reference counts the next
+ * time it releases an Object, or when it exits. Once the Owner has exited, other threads merge on
+ * its behalf.
+ */
+typedef struct {
+
+	/**
+	 * @brief The lock, which guards the queue and, once the Owner has exited, `owned`.
+	 */
+	pthread_mutex_t lock;
+
+	/**
+	 * @brief The Objects queued to this Owner by other threads.
+	 */
+	Object **queue;
+
+	/**
+	 * @brief The count and capacity of `queue`.
+	 */
+	size_t count, capacity;
+
+	/**
+	 * @brief True if `queue` is not empty.
+	 */
+	volatile _Bool pending;
+
+	/**
+	 * @brief True until the owning thread exits.
+	 */
+	_Bool alive;
+
+	/**
+	 * @brief The count of Objects owned by this Owner whose reference counts are not yet merged.
+	 */
+	size_t owned;
+} Owner;
+
+static pthread_key_t _ownerKey;
+static pthread_once_t _ownerOnce = PTHREAD_ONCE_INIT;
+
+static __thread Owner *_owner;
+
+/**
+ * @brief The weak references to an Object.
+ */
+typedef struct WeakEntry WeakEntry;
+
+struct WeakEntry {
+
+	/**
+	 * @brief The next WeakEntry in the bucket.
+	 */
+	WeakEntry *next;
+
+	/**
+	 * @brief The weakly referenced Object.
+	 */
+	const Object *object;
+
+	/**
+	 * @brief The locations referencing the Object.
+	 */
+	ident **locations;
+
+	/**
+	 * @brief The count and capacity of `locations`.
+	 */
+	size_t count, capacity;
+};
+
+/**
+ * @brief A stripe of the weak reference table, which maps Objects to WeakEntries.
+ */
+typedef struct {
+
+	/**
+	 * @brief The lock, which is held for reading by `loadWeak`, and for writing otherwise.
+	 */
+	pthread_rwlock_t lock;
+
+	/**
+	 * @brief The hash buckets.
+	 */
+	WeakEntry **buckets;
+
+	/**
+	 * @brief The count of buckets, which is always a power of two, and the count of WeakEntries.
+	 */
+	size_t capacity, count;
+} WeakStripe;
+
+static WeakStripe _weakTable[WEAK_TABLE_STRIPES];
+static pthread_once_t _weakOnce = PTHREAD_ONCE_INIT;
+
+static volatile unsigned _shards;
+
+static pthread_key_t _shardKey;
+static pthread_once_t _shardOnce = PTHREAD_ONCE_INIT;
+
+static __thread unsigned _shard;
+
 /**
  * @brief Called `atexit` to teardown Objectively.
  */
@@ -58,6 +214,12 @@ static void teardown(void) {
 
 		ClassDef *next = c->next;
 
+		if (c->slab) {
+			SlabDestroy(c->slab);
+		}
+
+		free(c->ancestors);
+		free(c->counters);
 		free(c->interface);
 		free(c);
 
@@ -78,13 +240,457 @@ static void setup(void) {
 	_pageSize = sysconf(_SC_PAGESIZE);
 #endif
 
+	if (getenv("OBJECTIVELY_SLAB")) {
+		_slabAllocation = true;
+	}
+
+	if (getenv("OBJECTIVELY_STATISTICS")) {
+		_classStatistics = true;
+	}
+
 	atexit(teardown);
 }
 
+/**
+ * @brief Tests the display of `def` for `superclass`.
+ */
+static inline _Bool isSubclassOfClassDef(const ClassDef *def, const ClassDef *superclass) {
+	return superclass && def->depth >= superclass->depth && def->ancestors[superclass->depth] == superclass;
+}
+
+/**
+ * @return The registry bucket for the given Class name.
+ */
+static ClassDef **bucket(const char *name) {
+	return &_registry[(unsigned) HashForCString(HASH_SEED, name) % CLASS_REGISTRY_SIZE];
+}
+
+/**
+ * @brief Publishes the given ClassDef to the list of Classes, and to the registry.
+ * @remarks Both are append-only, so that they may be read without locking.
+ */
+static void publish(ClassDef *def) {
+
+	ClassDef **chain = bucket(def->descriptor.name);
+
+	do {
+		def->chain = *chain;
+	} while (!__sync_bool_compare_and_swap(chain, def->chain, def));
+
+	do {
+		def->next = _classes;
+	} while (!__sync_bool_compare_and_swap(&_classes, def->next, def));
+}
+
+/**
+ * @brief Frees the given Owner once all of its Objects have been merged.
+ */
+static void destroyOwner(Owner *owner) {
+
+	pthread_mutex_destroy(&owner->lock);
+
+	free(owner->queue);
+	free(owner);
+}
+
+/**
+ * @brief Initializes the weak reference table.
+ */
+static void createWeakTable(void) {
+
+	for (size_t i = 0; i < WEAK_TABLE_STRIPES; i++) {
+		const int err = pthread_rwlock_init(&_weakTable[i].lock, NULL);
+		assert(err == 0);
+	}
+}
+
+/**
+ * @return The hash of the given Object's address.
+ */
+static inline size_t weakHash(const ident obj) {
+	return (size_t) (((uintptr_t) obj >> 4) * 0x9e3779b97f4a7c15ull >> 16);
+}
+
+/**
+ * @return The stripe of the weak reference table for the given Object.
+ */
+static inline WeakStripe *weakStripe(const ident obj) {
+	return &_weakTable[weakHash(obj) % WEAK_TABLE_STRIPES];
+}
+
+/**
+ * @return The bucket within the given stripe for the given Object.
+ */
+static inline WeakEntry **weakBucket(WeakStripe *stripe, const ident obj) {
+	return &stripe->buckets[(weakHash(obj) / WEAK_TABLE_STRIPES) & (stripe->capacity - 1)];
+}
+
+/**
+ * @return The WeakEntry for the given Object, optionally creating it.
+ * @remarks The stripe must be locked for writing to create the WeakEntry.
+ */
+static WeakEntry *weakEntry(WeakStripe *stripe, const Object *object, _Bool create) {
+
+	if (stripe->capacity) {
+		for (WeakEntry *e = *weakBucket(stripe, (ident) object); e; e = e->next) {
+			if (e->object == object) {
+				return e;
+			}
+		}
+	}
+
+	if (create == false) {
+		return NULL;
+	}
+
+	if (stripe->count == stripe->capacity) {
+
+		WeakEntry **buckets = stripe->buckets;
+		const size_t capacity = stripe->capacity;
+
+		stripe->capacity = capacity ? capacity << 1 : 16;
+		stripe->buckets = calloc(stripe->capacity, sizeof(WeakEntry *));
+		assert(stripe->buckets);
+
+		for (size_t i = 0; i < capacity; i++) {
+			WeakEntry *e = buckets[i];
+			while (e) {
+				WeakEntry *next = e->next;
+				WeakEntry **bucket = weakBucket(stripe, (ident) e->object);
+				e->next = *bucket;
+				*bucket = e;
+				e = next;
+			}
+		}
+
+		free(buckets);
+	}
+
+	WeakEntry *entry = calloc(1, sizeof(WeakEntry));
+	assert(entry);
+
+	entry->object = object;
+
+	WeakEntry **bucket = weakBucket(stripe, (ident) object);
+	entry->next = *bucket;
+	*bucket = entry;
+
+	stripe->count++;
+
+	return entry;
+}
+
+/**
+ * @brief Removes and frees the given WeakEntry.
+ * @remarks The stripe must be locked for writing.
+ */
+static void removeWeakEntry(WeakStripe *stripe, WeakEntry *entry) {
+
+	WeakEntry **e = weakBucket(stripe, (ident) entry->object);
+	while (*e != entry) {
+		e = &(*e)->next;
+	}
+
+	*e = entry->next;
+	stripe->count--;
+
+	free(entry->locations);
+	free(entry);
+}
+
+/**
+ * @brief Deallocates the given Object, first zeroing any weak references to it.
+ * @param shared The final shared reference count of the Object.
+ */
+static void deallocate(Object *object, int shared) {
+
+	if (shared & SHARED_WEAK) {
+
+		WeakStripe *stripe = weakStripe(object);
+		pthread_rwlock_wrlock(&stripe->lock);
+
+		WeakEntry *entry = weakEntry(stripe, object, false);
+		if (entry) {
+			for (size_t i = 0; i < entry->count; i++) {
+				if (*entry->locations[i] == object) {
+					*entry->locations[i] = NULL;
+				}
+			}
+			removeWeakEntry(stripe, entry);
+		}
+
+		pthread_rwlock_unlock(&stripe->lock);
+	}
+
+	$(object, dealloc);
+}
+
+/**
+ * @brief Merges the owner's reference count of the given Object into its shared reference count.
+ * @details This is performed by the owning thread, or on its behalf once it has exited. Hereafter,
+ * the Object is reference counted atomically by all threads.
+ */
+static void merge(Object *object) {
+
+	const int biased = object->referenceCount * SHARED_ONE;
+
+	object->referenceCount = 0;
+	object->owner = NULL;
+
+	int old, new;
+	do {
+		old = object->sharedReferenceCount;
+		new = ((old + biased) | SHARED_MERGED) & ~SHARED_QUEUED;
+	} while (__sync_val_compare_and_swap(&object->sharedReferenceCount, old, new) != old);
+
+	if (SHARED_IS_DEAD(new)) {
+		deallocate(object, new);
+	}
+}
+
+/**
+ * @brief Merges the Objects queued to the given Owner by other threads.
+ * @remarks This must be called by the owning thread.
+ */
+static void settle(Owner *owner) {
+
+	while (owner->pending) {
+
+		pthread_mutex_lock(&owner->lock);
+
+		Object **queue = owner->queue;
+		const size_t count = owner->count;
+
+		owner->queue = NULL;
+		owner->count = owner->capacity = 0;
+		owner->pending = false;
+
+		pthread_mutex_unlock(&owner->lock);
+
+		for (size_t i = 0; i < count; i++) {
+			merge(queue[i]);
+			owner->owned--;
+		}
+
+		free(queue);
+	}
+}
+
+/**
+ * @brief Settles the exiting thread's Owner, and frees it if it owns no unmerged Objects.
+ */
+static void releaseOwner(ident data) {
+
+	Owner *owner = (Owner *) data;
+	_Bool done;
+
+	while (true) {
+
+		settle(owner);
+
+		pthread_mutex_lock(&owner->lock);
+
+		if (owner->pending) {
+			pthread_mutex_unlock(&owner->lock);
+			continue;
+		}
+
+		owner->alive = false;
+		done = owner->owned == 0;
+
+		pthread_mutex_unlock(&owner->lock);
+		break;
+	}
+
+	_owner = NULL;
+
+	if (done) {
+		destroyOwner(owner);
+	}
+}
+
+/**
+ * @brief Creates the key through which Owners are released.
+ */
+static void createOwnerKey(void) {
+
+	const int err = pthread_key_create(&_ownerKey, releaseOwner);
+	assert(err == 0);
+}
+
+/**
+ * @return The calling thread's Owner, which is created on demand.
+ */
+static Owner *owner(void) {
+
+	if (_owner == NULL) {
+
+		Owner *owner = calloc(1, sizeof(Owner));
+		assert(owner);
+
+		const int err = pthread_mutex_init(&owner->lock, NULL);
+		assert(err == 0);
+
+		owner->alive = true;
+
+		pthread_once(&_ownerOnce, createOwnerKey);
+		pthread_setspecific(_ownerKey, owner);
+
+		_owner = owner;
+	}
+
+	return _owner;
+}
+
+/**
+ * @brief Queues the given Object to its Owner, or merges it if the Owner has exited.
+ */
+static void enqueue(Owner *owner, Object *object) {
+
+	pthread_mutex_lock(&owner->lock);
+
+	if (owner->alive) {
+
+		if (owner->count == owner->capacity) {
+			owner->capacity = owner->capacity ? owner->capacity << 1 : 16;
+
+			owner->queue = realloc(owner->queue, owner->capacity * sizeof(Object *));
+			assert(owner->queue);
+		}
+
+		owner->queue[owner->count++] = object;
+		owner->pending = true;
+
+		pthread_mutex_unlock(&owner->lock);
+		return;
+	}
+
+	pthread_mutex_unlock(&owner->lock);
+
+	merge(object);
+
+	pthread_mutex_lock(&owner->lock);
+	const _Bool done = --owner->owned == 0;
+	pthread_mutex_unlock(&owner->lock);
+
+	if (done) {
+		destroyOwner(owner);
+	}
+}
+
+/**
+ * @brief Returns the exiting thread's shard, so that it may be claimed by another thread.
+ * @remarks The shard's counters are not reset; they are carried forward by the next thread. Should
+ * a later destructor allocate or deallocate, the exiting thread claims a shard anew.
+ */
+static void releaseShard(ident data) {
+
+	const unsigned bit = 1u << ((uintptr_t) data - 1);
+
+	unsigned shards;
+	do {
+		shards = _shards;
+	} while (__sync_val_compare_and_swap(&_shards, shards, shards & ~bit) != shards);
+
+	_shard = 0;
+}
+
+/**
+ * @brief Creates the key through which shards are released.
+ */
+static void createShardKey(void) {
+
+	const int err = pthread_key_create(&_shardKey, releaseShard);
+	assert(err == 0);
+}
+
+/**
+ * @brief Claims an unused shard for the calling thread, or the shared shard if none remain.
+ * @return The shard index, plus one.
+ */
+static unsigned claimShard(void) {
+
+	pthread_once(&_shardOnce, createShardKey);
+
+	while (true) {
+		const unsigned shards = _shards;
+
+		unsigned i;
+		for (i = 1; i < CLASS_STATISTICS_SHARDS; i++) {
+			if ((shards & (1u << i)) == 0) {
+				break;
+			}
+		}
+
+		if (i == CLASS_STATISTICS_SHARDS) {
+			return 1;
+		}
+
+		if (__sync_val_compare_and_swap(&_shards, shards, shards | (1u << i)) == shards) {
+			pthread_setspecific(_shardKey, (ident) (uintptr_t) (i + 1));
+			return i + 1;
+		}
+	}
+}
+
+/**
+ * @brief Increments the given counter of the calling thread's shard.
+ * @return The incremented value.
+ */
+static inline long increment(ClassDef *def, size_t offset) {
+
+	if (_shard == 0) {
+		_shard = claimShard();
+	}
+
+	volatile long *counter = (volatile long *) ((uint8_t *) &def->counters[_shard - 1] + offset);
+
+	if (_shard == 1) {
+		return __sync_add_and_fetch(counter, 1);
+	} else {
+		return ++*counter;
+	}
+}
+
+/**
+ * @brief Sums the counters of the given ClassDef, and updates its peak.
+ * @remarks This function is async-signal-safe.
+ */
+static void sample(ClassDef *def, ClassStatistics *statistics) {
+
+	memset(statistics, 0, sizeof(*statistics));
+
+	statistics->clazz = &def->descriptor;
+
+	for (size_t i = 0; i < CLASS_STATISTICS_SHARDS; i++) {
+		statistics->allocations += def->counters[i].allocations;
+		statistics->deallocations += def->counters[i].deallocations;
+	}
+
+	if (statistics->allocations > statistics->deallocations) {
+		statistics->live = statistics->allocations - statistics->deallocations;
+	}
+
+	long peak;
+	do {
+		peak = def->peak;
+		if ((long) statistics->live <= peak) {
+			break;
+		}
+	} while (__sync_val_compare_and_swap(&def->peak, peak, (long) statistics->live) != peak);
+
+	statistics->peak = max((size_t) def->peak, statistics->live);
+	statistics->bytes = statistics->live * def->descriptor.instanceSize;
+}
+
 void _initialize(Class *clazz) {
 
 	assert(clazz);
 
+	if (_loadOnce(&clazz->magic) == CLASS_MAGIC) {
+		return;
+	}
+
 	if (__sync_val_compare_and_swap(&clazz->magic, 0, -1) == 0) {
 
 		assert(clazz->name);
@@ -112,6 +718,26 @@ void _initialize(Class *clazz) {
 			_initialize(super);
 
 			memcpy(def->interface, super->def->interface, super->interfaceSize);
+
+			def->depth = super->def->depth + 1;
+		}
+
+		def->ancestors = calloc(def->depth + 1, sizeof(ClassDef *));
+		assert(def->ancestors);
+
+		if (def->depth) {
+			memcpy(def->ancestors, clazz->superclass->def->ancestors, def->depth * sizeof(ClassDef *));
+		}
+
+		def->ancestors[def->depth] = def;
+
+		if (_slabAllocation) {
+			def->slab = SlabCreate(clazz->instanceSize);
+		}
+
+		if (_classStatistics) {
+			def->counters = calloc(CLASS_STATISTICS_SHARDS, sizeof(ClassCounters));
+			assert(def->counters);
 		}
 
 		if (clazz->initialize) {
@@ -119,14 +745,13 @@ void _initialize(Class *clazz) {
 		}
 
 		def->descriptor.magic = CLASS_MAGIC;
-		def->next = __sync_lock_test_and_set(&_classes, def);
 
-		clazz->magic = CLASS_MAGIC;
+		publish(def);
+
+		_wakeOnce(&clazz->magic, CLASS_MAGIC);
 
 	} else {
-		while (clazz->magic != CLASS_MAGIC) {
-			;
-		}
+		_waitOnce(&clazz->magic, CLASS_MAGIC);
 	}
 }
 
@@ -134,14 +759,30 @@ ident _alloc(Class *clazz) {
 
 	_initialize(clazz);
 
-	ident obj = calloc(1, clazz->instanceSize);
+	ident obj;
+	if (clazz->def->slab) {
+		obj = SlabAllocate(clazz->def->slab);
+	} else {
+		obj = calloc(1, clazz->instanceSize);
+	}
 	assert(obj);
 
 	Object *object = (Object *) obj;
 
 	object->clazz = clazz;
 	object->referenceCount = 1;
+	object->owner = owner();
+
+	((Owner *) object->owner)->owned++;
 
+	ClassDef *def = clazz->def;
+	if (def->counters) {
+		const long allocations = increment(def, offsetof(ClassCounters, allocations));
+		if (allocations % CLASS_STATISTICS_SAMPLE == 0) {
+			ClassStatistics statistics;
+			sample(def, &statistics);
+		}
+	}
 
 	ident interface = clazz->def->interface;
 	do {
@@ -151,21 +792,37 @@ ident _alloc(Class *clazz) {
 	return obj;
 }
 
-ident _cast(Class *clazz, const ident obj) {
+void _dealloc(ident obj) {
 
-	if (obj) {
-		const Class *c = ((Object *) obj)->clazz;
-		while (c) {
+	Object *object = (Object *) obj;
 
-			// as a special case, we optimize for _Object
+	assert(object);
 
-			if (c == clazz || clazz == _Object()) {
-				break;
-			}
+	ClassDef *def = object->clazz->def;
+	if (def->counters) {
+		increment(def, offsetof(ClassCounters, deallocations));
+	}
 
-			c = c->superclass;
-		}
-		assert(c);
+	Slab *slab = def->slab;
+	if (slab) {
+		SlabFree(slab, obj);
+	} else {
+		free(obj);
+	}
+}
+
+_Bool isSubclassOfClass(const Class *clazz, const Class *superclass) {
+
+	assert(clazz);
+	assert(superclass);
+
+	return clazz->def && isSubclassOfClassDef(clazz->def, superclass->def);
+}
+
+ident _cast(Class *clazz, const ident obj) {
+
+	if (obj) {
+		assert(isSubclassOfClassDef(((Object *) obj)->clazz->def, clazz->def));
 	}
 
 	return (ident) obj;
@@ -174,38 +831,393 @@ ident _cast(Class *clazz, const ident obj) {
 Class *classForName(const char *name) {
 
 	if (name) {
-		ClassDef *c = _classes;
+		ClassDef *c = *bucket(name);
 		while (c) {
 			if (strcmp(name, c->descriptor.name) == 0) {
 				return &c->descriptor;
 			}
-			c = c->next;
+			c = c->chain;
 		}
 	}
 
 	return NULL;
 }
 
+void enumerateClasses(ClassEnumerator enumerator, ident data) {
+
+	assert(enumerator);
+
+	for (ClassDef *c = _classes; c; c = c->next) {
+		if (enumerator(&c->descriptor, data)) {
+			break;
+		}
+	}
+}
+
+void enumerateSubclasses(const Class *clazz, ClassEnumerator enumerator, ident data) {
+
+	assert(clazz);
+	assert(enumerator);
+
+	const ClassDef *def = clazz->def;
+	if (def == NULL) {
+		return;
+	}
+
+	for (ClassDef *c = _classes; c; c = c->next) {
+		if (c != def && isSubclassOfClassDef(c, def)) {
+			if (enumerator(&c->descriptor, data)) {
+				break;
+			}
+		}
+	}
+}
+
+_Bool statisticsForClass(const Class *clazz, ClassStatistics *statistics) {
+
+	assert(clazz);
+	assert(statistics);
+
+	ClassDef *def = clazz->def;
+	if (def && def->counters) {
+		sample(def, statistics);
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Appends the given string to the buffer.
+ * @remarks This function is async-signal-safe.
+ */
+static char *appendString(char *buffer, const char *limit, const char *string) {
+
+	while (*string && buffer < limit) {
+		*buffer++ = *string++;
+	}
+
+	return buffer;
+}
+
+/**
+ * @brief Appends the given unsigned integer to the buffer.
+ * @remarks This function is async-signal-safe.
+ */
+static char *appendNumber(char *buffer, const char *limit, size_t number) {
+
+	char digits[24], *d = digits + sizeof(digits);
+
+	*--d = '\0';
+	do {
+		*--d = '0' + number % 10;
+		number /= 10;
+	} while (number);
+
+	return appendString(buffer, limit, d);
+}
+
+void dumpClassStatistics(int fd) {
+
+	for (ClassDef *c = _classes; c; c = c->next) {
+		if (c->counters) {
+
+			ClassStatistics statistics;
+			sample(c, &statistics);
+
+			char line[256], *l = line;
+			const char *limit = line + sizeof(line) - 1;
+
+			l = appendString(l, limit, c->descriptor.name);
+			l = appendString(l, limit, ": allocations ");
+			l = appendNumber(l, limit, statistics.allocations);
+			l = appendString(l, limit, ", live ");
+			l = appendNumber(l, limit, statistics.live);
+			l = appendString(l, limit, ", peak ");
+			l = appendNumber(l, limit, statistics.peak);
+			l = appendString(l, limit, ", bytes ");
+			l = appendNumber(l, limit, statistics.bytes);
+
+			*l++ = '\n';
+
+			if (write(fd, line, l - line) < 0) {
+				break;
+			}
+		}
+	}
+}
+
+/**
+ * @brief The signal handler installed by `dumpClassStatisticsOnSignal`.
+ */
+static void dumpClassStatisticsHandler(int sig) {
+	dumpClassStatistics(STDERR_FILENO);
+}
+
+void dumpClassStatisticsOnSignal(int sig) {
+	signal(sig, dumpClassStatisticsHandler);
+}
+
+ident immortalize(ident obj) {
+
+	Object *object = (Object *) obj;
+
+	assert(object);
+	assert(object->owner && object->owner == _owner);
+
+	((Owner *) object->owner)->owned--;
+
+	object->owner = NULL;
+	object->sharedReferenceCount = SHARED_IMMORTAL;
+
+	return obj;
+}
+
+ident autorelease(ident obj) {
+
+	if (obj) {
+		AutoreleasePool *pool = $$(AutoreleasePool, currentPool);
+		if (pool) {
+			$(pool, addObject, obj);
+		} else {
+			fprintf(stderr, "WARNING:%s: no AutoreleasePool in place, leaking %s@%p\n",
+					__func__, ((Object *) obj)->clazz->name, obj);
+		}
+	}
+
+	return obj;
+}
+
 void release(ident obj) {
 
 	if (obj) {
-		Object *object = cast(Object, obj);
+		Object *object = (Object *) obj;
+
+		Owner *owner = object->owner;
+		if (owner && owner == _owner) {
+
+			if (--object->referenceCount == 0) {
+
+				int old;
+				do {
+					old = object->sharedReferenceCount;
+				} while (__sync_val_compare_and_swap(&object->sharedReferenceCount, old, old | SHARED_MERGED) != old);
+
+				object->owner = NULL;
 
-		assert(object);
+				if ((old & SHARED_QUEUED) == 0) {
+					owner->owned--;
 
-		if (__sync_add_and_fetch(&object->referenceCount, -1) == 0) {
-			$(object, dealloc);
+					if ((old & ~SHARED_WEAK) == 0) {
+						deallocate(object, old | SHARED_MERGED);
+					}
+				}
+			}
+
+			if (owner->pending) {
+				settle(owner);
+			}
+		} else {
+
+			if (object->sharedReferenceCount & SHARED_IMMORTAL) {
+				return;
+			}
+
+			int old, new;
+			do {
+				old = object->sharedReferenceCount;
+				new = old - SHARED_ONE;
+
+				if (new < 0 && (old & (SHARED_MERGED | SHARED_QUEUED)) == 0) {
+					new |= SHARED_QUEUED;
+				}
+			} while (__sync_val_compare_and_swap(&object->sharedReferenceCount, old, new) != old);
+
+			if (SHARED_IS_DEAD(new)) {
+				deallocate(object, new);
+			} else if ((new & SHARED_QUEUED) && (old & SHARED_QUEUED) == 0) {
+				enqueue(owner, object);
+			}
 		}
 	}
 }
 
 ident retain(ident obj) {
 
-	Object *object = cast(Object, obj);
+	Object *object = (Object *) obj;
 
 	assert(object);
 
-	__sync_add_and_fetch(&object->referenceCount, 1);
+	if (object->owner && object->owner == _owner) {
+		object->referenceCount++;
+	} else if ((object->sharedReferenceCount & SHARED_IMMORTAL) == 0) {
+		__sync_add_and_fetch(&object->sharedReferenceCount, SHARED_ONE);
+	}
 
 	return obj;
 }
+
+/**
+ * @brief Retains the given Object, unless it is being deallocated.
+ * @return True if the Object was retained, false otherwise.
+ */
+static _Bool tryRetain(Object *object) {
+
+	if (object->owner && object->owner == _owner) {
+		object->referenceCount++;
+		return true;
+	}
+
+	int old;
+	do {
+		old = object->sharedReferenceCount;
+
+		if (old & SHARED_IMMORTAL) {
+			return true;
+		}
+
+		if (SHARED_IS_DEAD(old)) {
+			return false;
+		}
+	} while (__sync_val_compare_and_swap(&object->sharedReferenceCount, old, old + SHARED_ONE) != old);
+
+	return true;
+}
+
+/**
+ * @brief Registers `location` as a weak reference to the given Object.
+ * @return True if the Object was registered, false if it is being deallocated.
+ * @remarks The Object's stripe must be locked for writing.
+ */
+static _Bool registerWeak(WeakStripe *stripe, Object *object, ident *location) {
+
+	int old;
+	do {
+		old = object->sharedReferenceCount;
+
+		if (old & (SHARED_IMMORTAL | SHARED_WEAK)) {
+			break;
+		}
+
+		if (SHARED_IS_DEAD(old)) {
+			return false;
+		}
+	} while (__sync_val_compare_and_swap(&object->sharedReferenceCount, old, old | SHARED_WEAK) != old);
+
+	if (old & SHARED_IMMORTAL) {
+		return true;
+	}
+
+	if (SHARED_IS_DEAD(old)) {
+		return false;
+	}
+
+	WeakEntry *entry = weakEntry(stripe, object, true);
+
+	if (entry->count == entry->capacity) {
+		entry->capacity = entry->capacity ? entry->capacity << 1 : 4;
+
+		entry->locations = realloc(entry->locations, entry->capacity * sizeof(ident *));
+		assert(entry->locations);
+	}
+
+	entry->locations[entry->count++] = location;
+	return true;
+}
+
+/**
+ * @brief Unregisters `location` as a weak reference to the given Object.
+ * @remarks The Object's stripe must be locked for writing.
+ */
+static void unregisterWeak(WeakStripe *stripe, const Object *object, ident *location) {
+
+	WeakEntry *entry = weakEntry(stripe, object, false);
+	if (entry) {
+		for (size_t i = 0; i < entry->count; i++) {
+			if (entry->locations[i] == location) {
+				entry->locations[i] = entry->locations[--entry->count];
+				break;
+			}
+		}
+
+		if (entry->count == 0) {
+			removeWeakEntry(stripe, entry);
+		}
+	}
+}
+
+void storeWeak(ident *location, ident obj) {
+
+	assert(location);
+
+	pthread_once(&_weakOnce, createWeakTable);
+
+	while (true) {
+		Object *old = *location;
+
+		WeakStripe *a = old ? weakStripe(old) : NULL;
+		WeakStripe *b = obj ? weakStripe(obj) : NULL;
+
+		if (a > b) {
+			WeakStripe *c = a; a = b; b = c;
+		}
+
+		if (a) {
+			pthread_rwlock_wrlock(&a->lock);
+		}
+		if (b && b != a) {
+			pthread_rwlock_wrlock(&b->lock);
+		}
+
+		const _Bool unchanged = *location == old;
+		if (unchanged) {
+
+			if (old) {
+				unregisterWeak(weakStripe(old), old, location);
+			}
+
+			if (obj && registerWeak(weakStripe(obj), (Object *) obj, location)) {
+				*location = obj;
+			} else {
+				*location = NULL;
+			}
+		}
+
+		if (b && b != a) {
+			pthread_rwlock_unlock(&b->lock);
+		}
+		if (a) {
+			pthread_rwlock_unlock(&a->lock);
+		}
+
+		if (unchanged) {
+			break;
+		}
+	}
+}
+
+ident loadWeak(ident *location) {
+
+	assert(location);
+
+	pthread_once(&_weakOnce, createWeakTable);
+
+	while (true) {
+		Object *object = *location;
+		if (object == NULL) {
+			return NULL;
+		}
+
+		WeakStripe *stripe = weakStripe(object);
+		pthread_rwlock_rdlock(&stripe->lock);
+
+		const _Bool unchanged = *location == object;
+		const _Bool retained = unchanged && tryRetain(object);
+
+		pthread_rwlock_unlock(&stripe->lock);
+
+		if (unchanged) {
+			return retained ? object : NULL;
+		}
+	}
+}
@@ -25,6 +25,7 @@
 
 #include <Objectively/Types.h>
 #include <Objectively/Once.h>
+#include <Objectively/Slab.h>
 
 /**
  * @file
@@ -36,6 +37,23 @@
  */
 #define CLASS_MAGIC 0xabcdef
 
+/**
+ * @brief The number of buckets in the Class registry, which is indexed by Class name.
+ */
+#define CLASS_REGISTRY_SIZE 1024
+
+/**
+ * @brief The number of shards across which each Class' statistics are counted.
+ * @details Each thread claims a shard of its own, in which it counts without atomic operations.
+ * Threads beyond the number of shards share the first shard, and count into it atomically.
+ */
+#define CLASS_STATISTICS_SHARDS 32
+
+/**
+ * @brief The peak live instance count is sampled at this interval of allocations, per shard.
+ */
+#define CLASS_STATISTICS_SAMPLE 256
+
 typedef struct ClassDef ClassDef;
 typedef struct Class Class;
 
@@ -108,6 +126,28 @@ struct Class {
 	Class *superclass;
 };
 
+/**
+ * @brief Allocation counters for one shard of a Class' statistics.
+ * @see CLASS_STATISTICS_SHARDS
+ */
+typedef struct {
+
+	/**
+	 * @brief The count of instances allocated.
+	 */
+	volatile long allocations;
+
+	/**
+	 * @brief The count of instances deallocated.
+	 */
+	volatile long deallocations;
+
+	/**
+	 * @brief Pads each shard to its own cache line.
+	 */
+	char padding[64 - 2 * sizeof(long)];
+} ClassCounters;
+
 /**
  * @brief The runtime representation of a Class.
  */
@@ -127,8 +167,89 @@ struct ClassDef {
 	 * @brief Provides chaining of initialized Classes.
 	 */
 	ClassDef *next;
+
+	/**
+	 * @brief Provides chaining of Classes within a bucket of the registry.
+	 */
+	ClassDef *chain;
+
+	/**
+	 * @brief The depth of the Class in the hierarchy, where `Object` is at depth `0`.
+	 */
+	size_t depth;
+
+	/**
+	 * @brief The display of ancestors, indexed by depth, ending with this Class.
+	 * @details A Class `c` descends from a Class `s` if and only if `c->def->depth >= s->def->depth`
+	 * and `c->def->ancestors[s->def->depth] == s->def`.
+	 */
+	ClassDef **ancestors;
+
+	/**
+	 * @brief The Slab from which instances are allocated, if slab allocation is enabled.
+	 * @see _slabAllocation
+	 */
+	Slab *slab;
+
+	/**
+	 * @brief The allocation counters, one per shard, if statistics are enabled.
+	 * @see _classStatistics
+	 */
+	ClassCounters *counters;
+
+	/**
+	 * @brief The greatest live instance count that has been sampled.
+	 */
+	volatile long peak;
 };
 
+/**
+ * @brief A snapshot of a Class' allocation statistics.
+ * @see statisticsForClass
+ */
+typedef struct {
+
+	/**
+	 * @brief The Class.
+	 */
+	const Class *clazz;
+
+	/**
+	 * @brief The count of instances allocated.
+	 */
+	size_t allocations;
+
+	/**
+	 * @brief The count of instances deallocated.
+	 */
+	size_t deallocations;
+
+	/**
+	 * @brief The count of live instances.
+	 */
+	size_t live;
+
+	/**
+	 * @brief The greatest count of live instances that has been sampled.
+	 * @remarks Live instances are sampled periodically as they are allocated, and whenever
+	 * statistics are read. Short-lived spikes may therefore be missed.
+	 */
+	size_t peak;
+
+	/**
+	 * @brief The size, in bytes, of the live instances.
+	 */
+	size_t bytes;
+} ClassStatistics;
+
+/**
+ * @brief A function pointer for Class enumeration (iteration).
+ * @param clazz The Class for the current iteration.
+ * @param data User data.
+ * @return `true` to break the iteration, `false` to continue.
+ */
+typedef _Bool (*ClassEnumerator)(const Class *clazz, ident data);
+
 /**
  * @brief Initializes the given Class.
  */
@@ -139,6 +260,18 @@ OBJECTIVELY_EXPORT void _initialize(Class *clazz);
  */
 OBJECTIVELY_EXPORT ident _alloc(Class *clazz);
 
+/**
+ * @brief Returns the memory of the given Object to its Class.
+ * @remarks This is the counterpart to `_alloc`, and is called by `Object::dealloc`.
+ */
+OBJECTIVELY_EXPORT void _dealloc(ident obj);
+
+/**
+ * @return True if `clazz` is `superclass`, or a subclass of it, false otherwise.
+ * @remarks This test is performed in constant time.
+ */
+OBJECTIVELY_EXPORT _Bool isSubclassOfClass(const Class *clazz, const Class *superclass);
+
 /**
  * @brief Perform a type-checking cast.
  */
@@ -150,17 +283,98 @@ OBJECTIVELY_EXPORT ident _cast(Class *clazz, const ident obj);
 OBJECTIVELY_EXPORT Class *classForName(const char *name);
 
 /**
- * @brief Atomically decrement the given Object's reference count. If the
- * resulting reference count is `0`, the Object is deallocated.
+ * @brief Enumerates all initialized Classes with the given function.
+ * @param enumerator The enumerator function.
+ * @param data User data.
+ * @remarks Enumeration is lock-free, and is safe to perform while other Classes are initializing.
+ * Classes initialized during enumeration may or may not be visited.
+ */
+OBJECTIVELY_EXPORT void enumerateClasses(ClassEnumerator enumerator, ident data);
+
+/**
+ * @brief Enumerates all initialized subclasses of `clazz` with the given function.
+ * @param clazz The Class.
+ * @param enumerator The enumerator function.
+ * @param data User data.
+ * @remarks All descendants of `clazz`, but not `clazz` itself, are visited.
+ */
+OBJECTIVELY_EXPORT void enumerateSubclasses(const Class *clazz, ClassEnumerator enumerator, ident data);
+
+/**
+ * @brief Makes the given Object immortal, so that `retain` and `release` no longer affect it.
+ * @return The Object.
+ * @remarks Immortal Objects are never deallocated by `release`, and may be retained and released
+ * by any number of threads without contention. This is intended for shared instances, such as
+ * singletons. The Object must not yet have been shared with other threads.
+ */
+OBJECTIVELY_EXPORT ident immortalize(ident obj);
+
+/**
+ * @brief Reads the allocation statistics of the given Class.
+ * @param clazz The Class.
+ * @param statistics The ClassStatistics to populate.
+ * @return True if statistics are counted for `clazz`, false otherwise.
+ * @see _classStatistics
+ */
+OBJECTIVELY_EXPORT _Bool statisticsForClass(const Class *clazz, ClassStatistics *statistics);
+
+/**
+ * @brief Writes the allocation statistics of all counted Classes to the given file descriptor.
+ * @param fd The file descriptor, e.g. `STDERR_FILENO`.
+ * @remarks This function is async-signal-safe.
+ */
+OBJECTIVELY_EXPORT void dumpClassStatistics(int fd);
+
+/**
+ * @brief Installs a handler that dumps the allocation statistics to `stderr` upon `sig`.
+ * @param sig The signal, e.g. `SIGUSR1`.
+ */
+OBJECTIVELY_EXPORT void dumpClassStatisticsOnSignal(int sig);
+
+/**
+ * @brief Stores a zeroing weak reference to the given Object at `location`.
+ * @param location The location, which must be zero-filled, or hold a weak reference.
+ * @param obj The Object, or `NULL`.
+ * @remarks Weak references do not retain the Object. When the Object is deallocated, every weak
+ * reference to it is set to `NULL`. Before `location` goes out of scope, or is freed, clear it by
+ * storing `NULL`. Locations must only be read with `loadWeak`.
+ */
+OBJECTIVELY_EXPORT void storeWeak(ident *location, ident obj);
+
+/**
+ * @brief Loads the weak reference at `location`.
+ * @param location The location, which must have been written with `storeWeak`.
+ * @return The Object, retained, or `NULL` if it has been deallocated. Release it when finished.
+ */
+OBJECTIVELY_EXPORT ident loadWeak(ident *location);
+
+/**
+ * @brief Adds the given Object to the calling thread's current AutoreleasePool.
+ * @return The Object.
+ * @remarks The Object is released when the AutoreleasePool is drained. This allows a function to
+ * return a temporary Object without its caller having to release it. If the calling thread has
+ * no AutoreleasePool, a warning is printed and the Object is leaked.
+ * @see AutoreleasePool
+ */
+OBJECTIVELY_EXPORT ident autorelease(ident obj);
+
+/**
+ * @brief Decrement the given Object's reference count. If the resulting
+ * reference count is `0`, the Object is deallocated.
+ * @remarks Reference counting is biased towards the thread that allocated the
+ * Object: that thread decrements without atomic operations, while all other
+ * threads decrement atomically.
  */
 OBJECTIVELY_EXPORT void release(ident obj);
 
 /**
- * @brief Atomically increment the given Object's reference count.
+ * @brief Increment the given Object's reference count.
  * @return The Object.
  * @remarks By calling this, the caller is expressing ownership of the Object,
  * and preventing it from being released. Be sure to balance calls to `retain`
  * with calls to `release`.
+ * @remarks Like `release`, this is atomic only for threads other than the one
+ * that allocated the Object.
  */
 OBJECTIVELY_EXPORT ident retain(ident obj);
 
@@ -169,6 +383,23 @@ OBJECTIVELY_EXPORT ident retain(ident obj);
  */
 OBJECTIVELY_EXPORT size_t _pageSize;
 
+/**
+ * @brief If `true`, Classes initialized hereafter allocate their instances from a Slab.
+ * @details Slab allocation is opt-in. Set this before instantiating the Classes that should use
+ * it, or set the `OBJECTIVELY_SLAB` environment variable to enable it for all Classes. Each Class
+ * retains the allocation strategy it was initialized with for the lifetime of the process.
+ */
+OBJECTIVELY_EXPORT _Bool _slabAllocation;
+
+/**
+ * @brief If `true`, Classes initialized hereafter count their allocations.
+ * @details Statistics are opt-in. Set this before instantiating the Classes that should be counted,
+ * or set the `OBJECTIVELY_STATISTICS` environment variable to enable them for all Classes.
+ * Counters are sharded by thread, and are cheap enough to leave enabled in production.
+ * @see statisticsForClass
+ */
+OBJECTIVELY_EXPORT _Bool _classStatistics;
+
 /**
  * @brief Allocate and initialize and instance of `type`.
  */
@@ -202,13 +433,35 @@ OBJECTIVELY_EXPORT size_t _pageSize;
 		_obj->interface->method(_obj, ## __VA_ARGS__); \
 	})
 
+/**
+ * @brief Publishes and reads the interfaces cached by `$$` call sites.
+ * @details The store has release semantics and the load acquire semantics, so that a thread which
+ * observes the cached pointer also observes the initialized interface it points to.
+ */
+#if defined(__ATOMIC_ACQUIRE)
+ #define _loadInterface(location) __atomic_load_n(location, __ATOMIC_ACQUIRE)
+ #define _storeInterface(location, interface) __atomic_store_n(location, interface, __ATOMIC_RELEASE)
+#else
+ #define _loadInterface(location) ({ typeof(*(location)) _i = *(location); __sync_synchronize(); _i; })
+ #define _storeInterface(location, interface) ({ __sync_synchronize(); *(location) = (interface); })
+#endif
+
 /**
  * @brief Invoke a Class method.
+ * @details Each call site caches the interface of `type` the first time it is reached, so that
+ * subsequent invocations cost a single load before dispatch.
  */
 #define $$(type, method, ...) \
 	({ \
-		_initialize(_##type()); \
-		interfaceof(type, _##type())->method(__VA_ARGS__); \
+		static type##Interface *_cachedInterface; \
+		type##Interface *_interface = _loadInterface(&_cachedInterface); \
+		if (__builtin_expect(_interface == NULL, 0)) { \
+			Class *_clazz = _##type(); \
+			_initialize(_clazz); \
+			_interface = interfaceof(type, _clazz); \
+			_storeInterface(&_cachedInterface, _interface); \
+		} \
+		_interface->method(__VA_ARGS__); \
 	})
 
 /**
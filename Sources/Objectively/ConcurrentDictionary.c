@@ -0,0 +1,361 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <pthread.h>
+
+#include <Objectively/ConcurrentDictionary.h>
+#include <Objectively/Hash.h>
+#include <Objectively/MutableDictionary.h>
+
+#define _Class _ConcurrentDictionary
+
+/**
+ * @brief The number of lock stripes, which must be a power of two.
+ */
+#define CONCURRENTDICTIONARY_STRIPES 64
+
+/**
+ * @brief A lock stripe, guarding the pairs whose keys hash to it.
+ */
+typedef struct {
+
+	/**
+	 * @brief The readers-writer lock.
+	 */
+	pthread_rwlock_t lock;
+
+	/**
+	 * @brief The pairs.
+	 */
+	MutableDictionary *dictionary;
+} ConcurrentDictionaryStripe;
+
+/**
+ * @return The finalized hash of `key`, which selects its stripe and its slot within the stripe.
+ */
+static inline unsigned hashForKey(const ident key) {
+	return HashFinalize(HashForObject(HASH_SEED, key));
+}
+
+/**
+ * @return The lock stripe for `hash`.
+ * @remarks The stripe is selected by the high bits of the finalized hash, while each stripe's
+ * MutableDictionary indexes by the low bits.
+ */
+static inline ConcurrentDictionaryStripe *stripeForHash(const ConcurrentDictionary *self, unsigned hash) {
+
+	ConcurrentDictionaryStripe *stripes = self->stripes;
+	return &stripes[hash / (0x100000000ull / CONCURRENTDICTIONARY_STRIPES)];
+}
+
+#pragma mark - Object
+
+/**
+ * @see Object::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+
+	const ConcurrentDictionary *this = (ConcurrentDictionary *) self;
+
+	ConcurrentDictionary *that = $(alloc(ConcurrentDictionary), init);
+	if (that) {
+
+		ConcurrentDictionaryStripe *src = this->stripes;
+		ConcurrentDictionaryStripe *dest = that->stripes;
+
+		for (size_t i = 0; i < CONCURRENTDICTIONARY_STRIPES; i++) {
+
+			pthread_rwlock_rdlock(&src[i].lock);
+			$(dest[i].dictionary, addEntriesFromDictionary, (Dictionary *) src[i].dictionary);
+			pthread_rwlock_unlock(&src[i].lock);
+		}
+	}
+
+	return (Object *) that;
+}
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	ConcurrentDictionary *this = (ConcurrentDictionary *) self;
+
+	ConcurrentDictionaryStripe *stripes = this->stripes;
+	for (size_t i = 0; i < CONCURRENTDICTIONARY_STRIPES; i++) {
+
+		pthread_rwlock_destroy(&stripes[i].lock);
+		release(stripes[i].dictionary);
+	}
+
+	free(this->stripes);
+
+	super(Object, self, dealloc);
+}
+
+/**
+ * @see Object::description(const Object *)
+ */
+static String *description(const Object *self) {
+
+	Dictionary *dictionary = $((ConcurrentDictionary *) self, dictionary);
+
+	String *description = $((Object *) dictionary, description);
+
+	release(dictionary);
+
+	return description;
+}
+
+#pragma mark - ConcurrentDictionary
+
+/**
+ * @fn ident ConcurrentDictionary::computeObjectForKey(ConcurrentDictionary *self, const ident key, ConcurrentDictionaryFunction function, ident data)
+ * @memberof ConcurrentDictionary
+ */
+static ident computeObjectForKey(ConcurrentDictionary *self, const ident key, ConcurrentDictionaryFunction function, ident data) {
+
+	assert(key);
+	assert(function);
+
+	const unsigned hash = hashForKey(key);
+	ConcurrentDictionaryStripe *stripe = stripeForHash(self, hash);
+
+	pthread_rwlock_wrlock(&stripe->lock);
+
+	ident obj = _dictionaryObjectForKey((Dictionary *) stripe->dictionary, hash, key);
+	ident result = function(key, obj, data);
+
+	if (result) {
+		_mutableDictionarySetObjectForKey(stripe->dictionary, result, hash, key);
+	} else if (obj) {
+		_mutableDictionaryRemoveObjectForKey(stripe->dictionary, hash, key);
+	}
+
+	pthread_rwlock_unlock(&stripe->lock);
+
+	return result;
+}
+
+/**
+ * @fn size_t ConcurrentDictionary::count(const ConcurrentDictionary *self)
+ * @memberof ConcurrentDictionary
+ */
+static size_t count(const ConcurrentDictionary *self) {
+
+	ConcurrentDictionaryStripe *stripes = self->stripes;
+	size_t count = 0;
+
+	for (size_t i = 0; i < CONCURRENTDICTIONARY_STRIPES; i++) {
+
+		pthread_rwlock_rdlock(&stripes[i].lock);
+		count += ((Dictionary *) stripes[i].dictionary)->count;
+		pthread_rwlock_unlock(&stripes[i].lock);
+	}
+
+	return count;
+}
+
+/**
+ * @fn Dictionary *ConcurrentDictionary::dictionary(const ConcurrentDictionary *self)
+ * @memberof ConcurrentDictionary
+ */
+static Dictionary *dictionary(const ConcurrentDictionary *self) {
+
+	MutableDictionary *dictionary = $(alloc(MutableDictionary), init);
+
+	ConcurrentDictionaryStripe *stripes = self->stripes;
+	for (size_t i = 0; i < CONCURRENTDICTIONARY_STRIPES; i++) {
+
+		pthread_rwlock_rdlock(&stripes[i].lock);
+		$(dictionary, addEntriesFromDictionary, (Dictionary *) stripes[i].dictionary);
+		pthread_rwlock_unlock(&stripes[i].lock);
+	}
+
+	return (Dictionary *) dictionary;
+}
+
+/**
+ * @fn ConcurrentDictionary *ConcurrentDictionary::init(ConcurrentDictionary *self)
+ * @memberof ConcurrentDictionary
+ */
+static ConcurrentDictionary *init(ConcurrentDictionary *self) {
+
+	self = (ConcurrentDictionary *) super(Object, self, init);
+	if (self) {
+
+		ConcurrentDictionaryStripe *stripes = calloc(CONCURRENTDICTIONARY_STRIPES, sizeof(ConcurrentDictionaryStripe));
+		assert(stripes);
+
+		for (size_t i = 0; i < CONCURRENTDICTIONARY_STRIPES; i++) {
+
+			const int err = pthread_rwlock_init(&stripes[i].lock, NULL);
+			assert(err == 0);
+
+			stripes[i].dictionary = $$(MutableDictionary, dictionaryWithCapacity, 0);
+		}
+
+		self->stripes = stripes;
+	}
+
+	return self;
+}
+
+/**
+ * @fn ident ConcurrentDictionary::objectForKey(const ConcurrentDictionary *self, const ident key)
+ * @memberof ConcurrentDictionary
+ */
+static ident objectForKey(const ConcurrentDictionary *self, const ident key) {
+
+	const unsigned hash = hashForKey(key);
+	ConcurrentDictionaryStripe *stripe = stripeForHash(self, hash);
+
+	pthread_rwlock_rdlock(&stripe->lock);
+
+	ident obj = _dictionaryObjectForKey((Dictionary *) stripe->dictionary, hash, key);
+	if (obj) {
+		retain(obj);
+	}
+
+	pthread_rwlock_unlock(&stripe->lock);
+
+	return obj;
+}
+
+/**
+ * @fn void ConcurrentDictionary::removeAllObjects(ConcurrentDictionary *self)
+ * @memberof ConcurrentDictionary
+ */
+static void removeAllObjects(ConcurrentDictionary *self) {
+
+	ConcurrentDictionaryStripe *stripes = self->stripes;
+	for (size_t i = 0; i < CONCURRENTDICTIONARY_STRIPES; i++) {
+
+		pthread_rwlock_wrlock(&stripes[i].lock);
+		$(stripes[i].dictionary, removeAllObjects);
+		pthread_rwlock_unlock(&stripes[i].lock);
+	}
+}
+
+/**
+ * @fn void ConcurrentDictionary::removeObjectForKey(ConcurrentDictionary *self, const ident key)
+ * @memberof ConcurrentDictionary
+ */
+static void removeObjectForKey(ConcurrentDictionary *self, const ident key) {
+
+	const unsigned hash = hashForKey(key);
+	ConcurrentDictionaryStripe *stripe = stripeForHash(self, hash);
+
+	pthread_rwlock_wrlock(&stripe->lock);
+	_mutableDictionaryRemoveObjectForKey(stripe->dictionary, hash, key);
+	pthread_rwlock_unlock(&stripe->lock);
+}
+
+/**
+ * @fn void ConcurrentDictionary::setObjectForKey(ConcurrentDictionary *self, const ident obj, const ident key)
+ * @memberof ConcurrentDictionary
+ */
+static void setObjectForKey(ConcurrentDictionary *self, const ident obj, const ident key) {
+
+	const unsigned hash = hashForKey(key);
+	ConcurrentDictionaryStripe *stripe = stripeForHash(self, hash);
+
+	pthread_rwlock_wrlock(&stripe->lock);
+	_mutableDictionarySetObjectForKey(stripe->dictionary, obj, hash, key);
+	pthread_rwlock_unlock(&stripe->lock);
+}
+
+/**
+ * @fn ident ConcurrentDictionary::setObjectForKeyIfAbsent(ConcurrentDictionary *self, const ident obj, const ident key)
+ * @memberof ConcurrentDictionary
+ */
+static ident setObjectForKeyIfAbsent(ConcurrentDictionary *self, const ident obj, const ident key) {
+
+	const unsigned hash = hashForKey(key);
+	ConcurrentDictionaryStripe *stripe = stripeForHash(self, hash);
+
+	pthread_rwlock_wrlock(&stripe->lock);
+
+	ident existing = _dictionaryObjectForKey((Dictionary *) stripe->dictionary, hash, key);
+	if (existing == NULL) {
+		_mutableDictionarySetObjectForKey(stripe->dictionary, obj, hash, key);
+	}
+
+	ident result = retain(existing ?: obj);
+
+	pthread_rwlock_unlock(&stripe->lock);
+
+	return result;
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	ObjectInterface *object = (ObjectInterface *) clazz->def->interface;
+
+	object->copy = copy;
+	object->dealloc = dealloc;
+	object->description = description;
+
+	ConcurrentDictionaryInterface *concurrentDictionary = (ConcurrentDictionaryInterface *) clazz->def->interface;
+
+	concurrentDictionary->computeObjectForKey = computeObjectForKey;
+	concurrentDictionary->count = count;
+	concurrentDictionary->dictionary = dictionary;
+	concurrentDictionary->init = init;
+	concurrentDictionary->objectForKey = objectForKey;
+	concurrentDictionary->removeAllObjects = removeAllObjects;
+	concurrentDictionary->removeObjectForKey = removeObjectForKey;
+	concurrentDictionary->setObjectForKey = setObjectForKey;
+	concurrentDictionary->setObjectForKeyIfAbsent = setObjectForKeyIfAbsent;
+}
+
+/**
+ * @fn Class *ConcurrentDictionary::_ConcurrentDictionary(void)
+ * @memberof ConcurrentDictionary
+ */
+Class *_ConcurrentDictionary(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "ConcurrentDictionary";
+		clazz.superclass = _Object();
+		clazz.instanceSize = sizeof(ConcurrentDictionary);
+		clazz.interfaceOffset = offsetof(ConcurrentDictionary, interface);
+		clazz.interfaceSize = sizeof(ConcurrentDictionaryInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
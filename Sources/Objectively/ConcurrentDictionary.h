@@ -0,0 +1,184 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#pragma once
+
+#include <Objectively/Dictionary.h>
+
+/**
+ * @file
+ * @brief Thread-safe mutable key-value stores.
+ */
+
+typedef struct ConcurrentDictionary ConcurrentDictionary;
+typedef struct ConcurrentDictionaryInterface ConcurrentDictionaryInterface;
+
+/**
+ * @brief A function type for atomically computing the Object for a key.
+ * @param key The key.
+ * @param obj The Object currently stored for `key`, or `NULL`.
+ * @param data User data.
+ * @return The Object to store for `key`, retained, or `NULL` to remove `key`. The ConcurrentDictionary
+ * retains the Object separately; the returned reference is handed on to the caller of
+ * `ConcurrentDictionary::computeObjectForKey`, who must release it. Return `retain(obj)` to leave
+ * `obj` in place.
+ * @remarks This function is called while `key`'s lock stripe is held for writing, so it must not
+ * access the ConcurrentDictionary.
+ */
+typedef ident (*ConcurrentDictionaryFunction)(const ident key, ident obj, ident data);
+
+/**
+ * @brief Thread-safe mutable key-value stores.
+ * @details Keys are partitioned by hash across a fixed number of stripes, each guarding its own
+ * MutableDictionary with a readers-writer lock. Readers of a stripe proceed in parallel, and
+ * writers block only the readers and writers of their own stripe.
+ * @remarks Because another thread may remove or replace an Object at any time, methods which
+ * return Objects return them retained. The caller must release them.
+ * @extends Object
+ * @ingroup Collections
+ */
+struct ConcurrentDictionary {
+
+	/**
+	 * @brief The superclass.
+	 */
+	Object object;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	ConcurrentDictionaryInterface *interface;
+
+	/**
+	 * @brief The lock stripes.
+	 * @private
+	 */
+	ident stripes;
+};
+
+/**
+ * @brief The ConcurrentDictionary interface.
+ */
+struct ConcurrentDictionaryInterface {
+
+	/**
+	 * @brief The superclass interface.
+	 */
+	ObjectInterface objectInterface;
+
+	/**
+	 * @fn ident ConcurrentDictionary::computeObjectForKey(ConcurrentDictionary *self, const ident key, ConcurrentDictionaryFunction function, ident data)
+	 * @brief Atomically replaces the Object for `key` with the result of `function`.
+	 * @param self The ConcurrentDictionary.
+	 * @param key The key.
+	 * @param function The ConcurrentDictionaryFunction.
+	 * @param data User data.
+	 * @return The Object now stored for `key`, or `NULL` if `key` was removed. This is the reference
+ * returned by `function`, which the caller owns and must release.
+	 * @memberof ConcurrentDictionary
+	 */
+	ident (*computeObjectForKey)(ConcurrentDictionary *self, const ident key, ConcurrentDictionaryFunction function, ident data);
+
+	/**
+	 * @fn size_t ConcurrentDictionary::count(const ConcurrentDictionary *self)
+	 * @param self The ConcurrentDictionary.
+	 * @return The count of pairs in this ConcurrentDictionary, which may change as soon as it is read.
+	 * @memberof ConcurrentDictionary
+	 */
+	size_t (*count)(const ConcurrentDictionary *self);
+
+	/**
+	 * @fn Dictionary *ConcurrentDictionary::dictionary(const ConcurrentDictionary *self)
+	 * @param self The ConcurrentDictionary.
+	 * @return A Dictionary with the pairs of this ConcurrentDictionary.
+	 * @remarks Each stripe is copied atomically, but the stripes are not copied at the same instant.
+	 * @memberof ConcurrentDictionary
+	 */
+	Dictionary *(*dictionary)(const ConcurrentDictionary *self);
+
+	/**
+	 * @fn ConcurrentDictionary *ConcurrentDictionary::init(ConcurrentDictionary *self)
+	 * @brief Initializes this ConcurrentDictionary.
+	 * @param self The ConcurrentDictionary.
+	 * @return The initialized ConcurrentDictionary, or `NULL` on error.
+	 * @memberof ConcurrentDictionary
+	 */
+	ConcurrentDictionary *(*init)(ConcurrentDictionary *self);
+
+	/**
+	 * @fn ident ConcurrentDictionary::objectForKey(const ConcurrentDictionary *self, const ident key)
+	 * @param self The ConcurrentDictionary.
+	 * @param key The key.
+	 * @return The Object stored for `key`, retained, or `NULL`.
+	 * @memberof ConcurrentDictionary
+	 */
+	ident (*objectForKey)(const ConcurrentDictionary *self, const ident key);
+
+	/**
+	 * @fn void ConcurrentDictionary::removeAllObjects(ConcurrentDictionary *self)
+	 * @brief Removes all pairs from this ConcurrentDictionary.
+	 * @param self The ConcurrentDictionary.
+	 * @memberof ConcurrentDictionary
+	 */
+	void (*removeAllObjects)(ConcurrentDictionary *self);
+
+	/**
+	 * @fn void ConcurrentDictionary::removeObjectForKey(ConcurrentDictionary *self, const ident key)
+	 * @brief Removes the Object for `key` from this ConcurrentDictionary.
+	 * @param self The ConcurrentDictionary.
+	 * @param key The key.
+	 * @memberof ConcurrentDictionary
+	 */
+	void (*removeObjectForKey)(ConcurrentDictionary *self, const ident key);
+
+	/**
+	 * @fn void ConcurrentDictionary::setObjectForKey(ConcurrentDictionary *self, const ident obj, const ident key)
+	 * @brief Sets a pair in this ConcurrentDictionary.
+	 * @param self The ConcurrentDictionary.
+	 * @param obj The Object.
+	 * @param key The key.
+	 * @memberof ConcurrentDictionary
+	 */
+	void (*setObjectForKey)(ConcurrentDictionary *self, const ident obj, const ident key);
+
+	/**
+	 * @fn ident ConcurrentDictionary::setObjectForKeyIfAbsent(ConcurrentDictionary *self, const ident obj, const ident key)
+	 * @brief Sets a pair in this ConcurrentDictionary, unless `key` is already present.
+	 * @param self The ConcurrentDictionary.
+	 * @param obj The Object.
+	 * @param key The key.
+	 * @return The Object stored for `key`, retained: either the existing Object, or `obj`.
+	 * @memberof ConcurrentDictionary
+	 */
+	ident (*setObjectForKeyIfAbsent)(ConcurrentDictionary *self, const ident obj, const ident key);
+};
+
+/**
+ * @fn Class *ConcurrentDictionary::_ConcurrentDictionary(void)
+ * @brief The ConcurrentDictionary archetype.
+ * @return The ConcurrentDictionary Class.
+ * @memberof ConcurrentDictionary
+ */
+OBJECTIVELY_EXPORT Class *_ConcurrentDictionary(void);
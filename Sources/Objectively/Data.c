@@ -67,13 +67,18 @@ static int hash(const Object *self) {
 
 	Data *this = (Data *) self;
 
-	int hash = HASH_SEED;
-	hash = HashForInteger(hash, this->length);
+	if (this->hash == 0) {
 
-	const Range range = { 0, this->length };
-	hash = HashForBytes(hash, this->bytes, range);
+		int hash = HASH_SEED;
+		hash = HashForInteger(hash, this->length);
 
-	return hash;
+		const Range range = { 0, this->length };
+		hash = HashForBytes(hash, this->bytes, range);
+
+		this->hash = hash;
+	}
+
+	return this->hash;
 }
 
 /**
@@ -57,6 +57,8 @@ struct Data {
 
 	/**
 	 * @brief The bytes.
+	 * @remarks The hash of an immutable Data is cached, so its bytes must not be modified once
+	 * it has been hashed (e.g. added to a Set or used as a Dictionary key).
 	 */
 	uint8_t *bytes;
 
@@ -64,6 +66,13 @@ struct Data {
 	 * @brief The length of `bytes`.
 	 */
 	size_t length;
+
+	/**
+	 * @brief The hash, computed lazily, or `0` if it has not yet been computed.
+	 * @remarks MutableData does not cache its hash.
+	 * @private
+	 */
+	int hash;
 };
 
 typedef struct MutableData MutableData;
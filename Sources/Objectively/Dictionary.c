@@ -24,6 +24,7 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <Objectively/Dictionary.h>
 #include <Objectively/Hash.h>
@@ -33,6 +34,29 @@
 
 #define _Class _Dictionary
 
+#define DICTIONARY_MAX_LOAD 0.75
+
+/**
+ * @brief Returns the entry at `index`, or `NULL` if that slot is empty.
+ * @details Indices span the current table, and then the unmigrated slots of any previous table.
+ */
+static const DictionaryEntry *entryAtIndex(const Dictionary *self, size_t index) {
+
+	const DictionaryEntry *entry;
+
+	if (index < self->capacity) {
+		entry = &self->entries[index];
+	} else {
+		index -= self->capacity;
+		if (index < self->migrated) {
+			return NULL;
+		}
+		entry = &self->previousEntries[index];
+	}
+
+	return entry->key && entry->object ? entry : NULL;
+}
+
 #pragma mark - Object
 
 /**
@@ -55,30 +79,27 @@ static void dealloc(Object *self) {
 	Dictionary *this = (Dictionary *) self;
 
 	for (size_t i = 0; i < this->capacity; i++) {
-		release(this->elements[i]);
-	}
 
-	free(this->elements);
-
-	super(Object, self, dealloc);
-}
-
-/**
- * @brief A DictionaryEnumerator for description.
- */
-static _Bool description_enumerator(const Dictionary *dict, ident obj, ident key, ident data) {
-
-	MutableString *desc = (MutableString *) data;
+		const DictionaryEntry *entry = &this->entries[i];
+		if (entry->key) {
+			release(entry->key);
+			release(entry->object);
+		}
+	}
 
-	String *objDesc = $((Object *) obj, description);
-	String *keyDesc = $((Object *) key, description);
+	for (size_t i = this->migrated; i < this->previousCapacity; i++) {
 
-	$(desc, appendFormat, "%s: %s, ", keyDesc->chars, objDesc->chars);
+		const DictionaryEntry *entry = &this->previousEntries[i];
+		if (entry->key) {
+			release(entry->key);
+			release(entry->object);
+		}
+	}
 
-	release(objDesc);
-	release(keyDesc);
+	free(this->entries);
+	free(this->previousEntries);
 
-	return false;
+	super(Object, self, dealloc);
 }
 
 /**
@@ -92,7 +113,19 @@ static String *description(const Object *self) {
 
 	$(desc, appendCharacters, "{");
 
-	$(this, enumerateObjectsAndKeys, description_enumerator, desc);
+	DictionaryIterator iterator = $(this, iterator);
+	ident obj, key;
+
+	while ($(this, nextObjectAndKey, &iterator, &obj, &key)) {
+
+		String *objDesc = $((Object *) obj, description);
+		String *keyDesc = $((Object *) key, description);
+
+		$(desc, appendFormat, "%s: %s, ", keyDesc->chars, objDesc->chars);
+
+		release(objDesc);
+		release(keyDesc);
+	}
 
 	$(desc, appendCharacters, "}");
 
@@ -101,20 +134,22 @@ static String *description(const Object *self) {
 
 /**
  * @see Object::hash(const Object *)
+ * @remarks The hashes of the pairs are summed, so that the result is independent of their order.
  */
 static int hash(const Object *self) {
 
 	const Dictionary *this = (Dictionary *) self;
 
-	int hash = HashForInteger(HASH_SEED, this->count);
+	unsigned hash = HashForInteger(HASH_SEED, this->count);
 
-	for (size_t i = 0; i < this->capacity; i++) {
-		if (this->elements[i]) {
-			hash = HashForObject(hash, this->elements[i]);
-		}
+	DictionaryIterator iterator = $(this, iterator);
+	ident obj, key;
+
+	while ($(this, nextObjectAndKey, &iterator, &obj, &key)) {
+		hash += HashForObject(HashForObject(HASH_SEED, key), obj);
 	}
 
-	return hash;
+	return (int) hash;
 }
 
 /**
@@ -133,21 +168,18 @@ static _Bool isEqual(const Object *self, const Object *other) {
 
 		if (this->count == that->count) {
 
-			Array *keys = $(this, allKeys);
+			DictionaryIterator iterator = $(this, iterator);
+			ident obj, key;
 
-			for (size_t i = 0; i < keys->count; i++) {
-				const ident key = $(keys, objectAtIndex, i);
+			while ($(this, nextObjectAndKey, &iterator, &obj, &key)) {
 
-				const Object *thisObject = $(this, objectForKey, key);
 				const Object *thatObject = $(that, objectForKey, key);
 
-				if ($(thisObject, isEqual, thatObject) == false) {
-					release(keys);
+				if ($((Object *) obj, isEqual, thatObject) == false) {
 					return false;
 				}
 			}
 
-			release(keys);
 			return true;
 		}
 	}
@@ -207,31 +239,72 @@ static Dictionary *dictionaryWithDictionary(const Dictionary *dictionary) {
 }
 
 /**
- * @fn Dictionary *Dictionary::dictionaryWithObjectsAndKeys(ident obj, ...)
- * @memberof Dictionary
+ * @brief Initializes `self` with the `NULL`-terminated list of Objects and keys, beginning with `obj`.
+ * @details The pairs are counted, and gathered into parallel arrays, so that the table is sized
+ * and populated in one pass.
  */
-static Dictionary *dictionaryWithObjectsAndKeys(ident obj, ...) {
+static Dictionary *initWithObjectsAndKeys_list(Dictionary *self, ident obj, va_list args) {
+
+	size_t count = 0;
+
+	va_list pairs;
+	va_copy(pairs, args);
+
+	for (ident o = obj; o; o = va_arg(pairs, ident)) {
+		va_arg(pairs, ident);
+		count++;
+	}
 
-	Dictionary *dict = (Dictionary *) $((Object *) alloc(Dictionary), init);
-	if (dict) {
+	va_end(pairs);
 
-		va_list args;
-		va_start(args, obj);
+	ident *objects = NULL, *keys = NULL;
 
-		while (obj) {
-			ident key = va_arg(args, ident);
+	if (count) {
+		objects = malloc(count * 2 * sizeof(ident));
+		assert(objects);
 
-			$$(MutableDictionary, setObjectForKey, (MutableDictionary *) dict, obj, key);
+		keys = objects + count;
+
+		for (size_t i = 0; i < count; i++) {
+			objects[i] = obj;
+			keys[i] = va_arg(args, ident);
 
 			obj = va_arg(args, ident);
 		}
-
-		va_end(args);
 	}
 
+	self = $(self, initWithObjectsForKeysCount, objects, keys, count);
+
+	free(objects);
+
+	return self;
+}
+
+/**
+ * @fn Dictionary *Dictionary::dictionaryWithObjectsAndKeys(ident obj, ...)
+ * @memberof Dictionary
+ */
+static Dictionary *dictionaryWithObjectsAndKeys(ident obj, ...) {
+
+	va_list args;
+	va_start(args, obj);
+
+	Dictionary *dict = initWithObjectsAndKeys_list((Dictionary *) alloc(Dictionary), obj, args);
+
+	va_end(args);
+
 	return dict;
 }
 
+/**
+ * @fn Dictionary *Dictionary::dictionaryWithObjectsForKeys(const Array *objects, const Array *keys)
+ * @memberof Dictionary
+ */
+static Dictionary *dictionaryWithObjectsForKeys(const Array *objects, const Array *keys) {
+
+	return $(alloc(Dictionary), initWithObjectsForKeys, objects, keys);
+}
+
 /**
  * @fn void Dictionary::enumerateObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator, ident data)
  * @memberof Dictionary
@@ -241,19 +314,13 @@ static void enumerateObjectsAndKeys(const Dictionary *self, DictionaryEnumerator
 
 	assert(enumerator);
 
-	for (size_t i = 0; i < self->capacity; i++) {
+	for (size_t i = 0; i < self->capacity + self->previousCapacity; i++) {
 
-		Array *array = self->elements[i];
-		if (array) {
+		const DictionaryEntry *entry = entryAtIndex(self, i);
+		if (entry) {
 
-			for (size_t j = 0; j < array->count; j += 2) {
-
-				ident key = $(array, objectAtIndex, j);
-				ident obj = $(array, objectAtIndex, j + 1);
-
-				if (enumerator(self, obj, key, data)) {
-					return;
-				}
+			if (enumerator(self, entry->object, entry->key, data)) {
+				return;
 			}
 		}
 	}
@@ -270,19 +337,13 @@ static Dictionary *filterObjectsAndKeys(const Dictionary *self, DictionaryEnumer
 
 	MutableDictionary *dictionary = $(alloc(MutableDictionary), init);
 
-	for (size_t i = 0; i < self->capacity; i++) {
-
-		Array *array = self->elements[i];
-		if (array) {
-
-			for (size_t j = 0; j < array->count; j += 2) {
+	for (size_t i = 0; i < self->capacity + self->previousCapacity; i++) {
 
-				ident key = $(array, objectAtIndex, j);
-				ident obj = $(array, objectAtIndex, j + 1);
+		const DictionaryEntry *entry = entryAtIndex(self, i);
+		if (entry) {
 
-				if (enumerator(self, obj, key, data)) {
-					$(dictionary, setObjectForKey, obj, key);
-				}
+			if (enumerator(self, entry->object, entry->key, data)) {
+				$(dictionary, setObjectForKey, entry->object, entry->key);
 			}
 		}
 	}
@@ -290,6 +351,13 @@ static Dictionary *filterObjectsAndKeys(const Dictionary *self, DictionaryEnumer
 	return (Dictionary *) dictionary;
 }
 
+/**
+ * @brief A DictionaryEnumerator for initWithDictionary.
+ */
+static _Bool initWithDictionary_enumerator(const Dictionary *dict, ident obj, ident key, ident data) {
+	$$(MutableDictionary, setObjectForKey, (MutableDictionary *) data, obj, key); return false;
+}
+
 /**
  * @fn Dictionary *Dictionary::initWithDictionary(Dictionary *self, const Dictionary *dictionary)
  * @memberof Dictionary
@@ -298,18 +366,34 @@ static Dictionary *initWithDictionary(Dictionary *self, const Dictionary *dictio
 
 	self = (Dictionary *) super(Object, self, init);
 	if (self) {
-		if (dictionary) {
+		if (dictionary && (dictionary->previousEntries ||
+				dictionary->interface->enumerateObjectsAndKeys != enumerateObjectsAndKeys)) {
 
 			self->capacity = dictionary->capacity;
+			if (self->capacity) {
+
+				self->entries = calloc(self->capacity, sizeof(DictionaryEntry));
+				assert(self->entries);
+			}
+
+			$(dictionary, enumerateObjectsAndKeys, initWithDictionary_enumerator, self);
+		} else if (dictionary) {
+
+			self->capacity = dictionary->capacity;
+			if (self->capacity) {
+
+				self->entries = malloc(self->capacity * sizeof(DictionaryEntry));
+				assert(self->entries);
 
-			self->elements = calloc(self->capacity, sizeof(ident));
-			assert(self->elements);
+				memcpy(self->entries, dictionary->entries, self->capacity * sizeof(DictionaryEntry));
 
-			for (size_t i = 0; i < dictionary->capacity; i++) {
+				for (size_t i = 0; i < self->capacity; i++) {
 
-				Array *array = dictionary->elements[i];
-				if (array) {
-					self->elements[i] = $((Object *) array, copy);
+					const DictionaryEntry *entry = &self->entries[i];
+					if (entry->key) {
+						retain(entry->key);
+						retain(entry->object);
+					}
 				}
 			}
 
@@ -326,30 +410,116 @@ static Dictionary *initWithDictionary(Dictionary *self, const Dictionary *dictio
  */
 static Dictionary *initWithObjectsAndKeys(Dictionary *self, ...) {
 
+	va_list args;
+	va_start(args, self);
+
+	ident obj = va_arg(args, ident);
+
+	self = initWithObjectsAndKeys_list(self, obj, args);
+
+	va_end(args);
+
+	return self;
+}
+
+/**
+ * @fn Dictionary *Dictionary::initWithObjectsForKeys(Dictionary *self, const Array *objects, const Array *keys)
+ * @memberof Dictionary
+ */
+static Dictionary *initWithObjectsForKeys(Dictionary *self, const Array *objects, const Array *keys) {
+
+	assert(objects);
+	assert(keys);
+	assert(objects->count == keys->count);
+
+	return $(self, initWithObjectsForKeysCount, objects->elements, keys->elements, keys->count);
+}
+
+/**
+ * @fn Dictionary *Dictionary::initWithObjectsForKeysCount(Dictionary *self, const ident *objects, const ident *keys, size_t count)
+ * @memberof Dictionary
+ */
+static Dictionary *initWithObjectsForKeysCount(Dictionary *self, const ident *objects, const ident *keys, size_t count) {
+
 	self = (Dictionary *) super(Object, self, init);
 	if (self) {
+		if (count) {
 
-		va_list args;
-		va_start(args, self);
+			assert(objects);
+			assert(keys);
 
-		while (true) {
+			unsigned *hashes = malloc(count * sizeof(unsigned));
+			assert(hashes);
 
-			ident obj = va_arg(args, ident);
-			if (obj) {
+			for (size_t i = 0; i < count; i++) {
+				assert(keys[i]);
+				hashes[i] = HashFinalize(HashForObject(HASH_SEED, keys[i]));
+			}
 
-				ident key = va_arg(args, ident);
-				$$(MutableDictionary, setObjectForKey, (MutableDictionary *) self, obj, key);
-			} else {
-				break;
+			self->capacity = 1;
+			while (count >= self->capacity * DICTIONARY_MAX_LOAD) {
+				self->capacity <<= 1;
 			}
-		}
 
-		va_end(args);
+			self->entries = calloc(self->capacity, sizeof(DictionaryEntry));
+			assert(self->entries);
+
+			const size_t mask = self->capacity - 1;
+
+			for (size_t n = 0; n < count; n++) {
+
+				assert(objects[n]);
+
+				const unsigned hash = hashes[n];
+				size_t i = hash & mask, distance = 0;
+
+				for (; ; i = (i + 1) & mask, distance++) {
+
+					DictionaryEntry *entry = &self->entries[i];
+
+					if (entry->key == NULL || ((i - entry->hash) & mask) < distance) {
+
+						const DictionaryEntry inserted = {
+							.key = retain(keys[n]),
+							.object = retain(objects[n]),
+							.hash = hash
+						};
+
+						_dictionaryPlaceEntry(self->entries, self->capacity, inserted, i, distance);
+
+						self->count++;
+						break;
+					}
+
+					if (entry->hash == hash && (entry->key == keys[n] || $((Object *) entry->key, isEqual, keys[n]))) {
+
+						retain(objects[n]);
+						release(entry->object);
+
+						entry->object = objects[n];
+						break;
+					}
+				}
+			}
+
+			free(hashes);
+		}
 	}
 
 	return self;
 }
 
+/**
+ * @fn DictionaryIterator Dictionary::iterator(const Dictionary *self)
+ * @memberof Dictionary
+ */
+static DictionaryIterator iterator(const Dictionary *self) {
+
+	return (DictionaryIterator) {
+		.index = 0
+	};
+}
+
 /**
  * @fn MutableDictionary *Dictionary::mutableCopy(const Dictionary *self)
  * @memberof Dictionary
@@ -365,23 +535,43 @@ static MutableDictionary *mutableCopy(const Dictionary *self) {
 }
 
 /**
- * @fn ident Dictionary::objectForKey(const Dictionary *self, const ident key)
+ * @fn _Bool Dictionary::nextObjectAndKey(const Dictionary *self, DictionaryIterator *iterator, ident *obj, ident *key)
  * @memberof Dictionary
  */
-static ident objectForKey(const Dictionary *self, const ident key) {
+static _Bool nextObjectAndKey(const Dictionary *self, DictionaryIterator *iterator, ident *obj, ident *key) {
 
-	const size_t bin = HashForObject(HASH_SEED, key) % self->capacity;
+	assert(iterator);
 
-	Array *array = self->elements[bin];
-	if (array) {
+	while (iterator->index < self->capacity + self->previousCapacity) {
 
-		const ssize_t index = $(array, indexOfObject, key);
-		if (index > -1) {
-			return $(array, objectAtIndex, index + 1);
+		const DictionaryEntry *entry = entryAtIndex(self, iterator->index++);
+		if (entry) {
+
+			if (obj) {
+				*obj = entry->object;
+			}
+			if (key) {
+				*key = entry->key;
+			}
+
+			return true;
 		}
 	}
 
-	return NULL;
+	return false;
+}
+
+/**
+ * @fn ident Dictionary::objectForKey(const Dictionary *self, const ident key)
+ * @memberof Dictionary
+ */
+static ident objectForKey(const Dictionary *self, const ident key) {
+
+	if (self->count == 0) {
+		return NULL;
+	}
+
+	return _dictionaryObjectForKey(self, HashFinalize(HashForObject(HASH_SEED, key)), key);
 }
 
 /**
@@ -422,11 +612,16 @@ static void initialize(Class *clazz) {
 	dictionary->allObjects = allObjects;
 	dictionary->dictionaryWithDictionary = dictionaryWithDictionary;
 	dictionary->dictionaryWithObjectsAndKeys = dictionaryWithObjectsAndKeys;
+	dictionary->dictionaryWithObjectsForKeys = dictionaryWithObjectsForKeys;
 	dictionary->enumerateObjectsAndKeys = enumerateObjectsAndKeys;
 	dictionary->filterObjectsAndKeys = filterObjectsAndKeys;
 	dictionary->initWithDictionary = initWithDictionary;
 	dictionary->initWithObjectsAndKeys = initWithObjectsAndKeys;
+	dictionary->initWithObjectsForKeys = initWithObjectsForKeys;
+	dictionary->initWithObjectsForKeysCount = initWithObjectsForKeysCount;
+	dictionary->iterator = iterator;
 	dictionary->mutableCopy = mutableCopy;
+	dictionary->nextObjectAndKey = nextObjectAndKey;
 	dictionary->objectForKey = objectForKey;
 	dictionary->objectForKeyPath = objectForKeyPath;
 }
@@ -451,5 +646,68 @@ Class *_Dictionary(void) {
 	return &clazz;
 }
 
+ssize_t _dictionaryEntryIndex(const DictionaryEntry *entries, size_t capacity, unsigned hash, const ident key) {
+
+	const size_t mask = capacity - 1;
+
+	for (size_t i = hash & mask, distance = 0; ; i = (i + 1) & mask, distance++) {
+
+		const DictionaryEntry *entry = &entries[i];
+
+		if (entry->key == NULL || ((i - entry->hash) & mask) < distance) {
+			return -1;
+		}
+
+		if (entry->object == NULL) {
+			continue;
+		}
+
+		if (entry->hash == hash && (entry->key == key || $((Object *) entry->key, isEqual, key))) {
+			return i;
+		}
+	}
+}
+
+ident _dictionaryObjectForKey(const Dictionary *self, unsigned hash, const ident key) {
+
+	if (self->count == 0) {
+		return NULL;
+	}
+
+	ssize_t index = _dictionaryEntryIndex(self->entries, self->capacity, hash, key);
+	if (index > -1) {
+		return self->entries[index].object;
+	}
+
+	if (self->previousEntries) {
+		index = _dictionaryEntryIndex(self->previousEntries, self->previousCapacity, hash, key);
+		if (index > -1) {
+			return self->previousEntries[index].object;
+		}
+	}
+
+	return NULL;
+}
+
+void _dictionaryPlaceEntry(DictionaryEntry *entries, size_t capacity, DictionaryEntry entry, size_t i, size_t distance) {
+
+	const size_t mask = capacity - 1;
+
+	for (; entries[i].key; i = (i + 1) & mask, distance++) {
+
+		const size_t displacement = (i - entries[i].hash) & mask;
+		if (displacement < distance) {
+
+			const DictionaryEntry displaced = entries[i];
+			entries[i] = entry;
+
+			entry = displaced;
+			distance = displacement;
+		}
+	}
+
+	entries[i] = entry;
+}
+
 #undef _Class
 
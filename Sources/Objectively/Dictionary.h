@@ -34,6 +34,30 @@
 typedef struct Dictionary Dictionary;
 typedef struct DictionaryInterface DictionaryInterface;
 
+/**
+ * @brief A slot in the open-addressed hash table of a Dictionary.
+ * @details Empty slots have a `NULL` key. Each occupied slot caches the hash of its key, so that
+ * probing and resizing need not invoke `Object::hash` or `Object::isEqual` needlessly.
+ * @private
+ */
+typedef struct {
+
+	/**
+	 * @brief The key, or `NULL` if this slot is empty.
+	 */
+	ident key;
+
+	/**
+	 * @brief The Object.
+	 */
+	ident object;
+
+	/**
+	 * @brief The hash of the key.
+	 */
+	unsigned hash;
+} DictionaryEntry;
+
 /**
  * @brief A function pointer for Dictionary enumeration (iteration).
  * @param dictionary The Dictionary.
@@ -44,6 +68,43 @@ typedef struct DictionaryInterface DictionaryInterface;
  */
 typedef _Bool (*DictionaryEnumerator)(const Dictionary *dictionary, ident obj, ident key, ident data);
 
+/**
+ * @brief The depth of the node stack of a DictionaryIterator.
+ */
+#define DICTIONARY_ITERATOR_DEPTH 8
+
+/**
+ * @brief A cursor for iterating a Dictionary without allocating.
+ * @details Obtain a DictionaryIterator with `Dictionary::iterator`, and advance it with
+ * `Dictionary::nextObjectAndKey`. The Dictionary must not be modified while it is iterated.
+ */
+typedef struct {
+
+	/**
+	 * @brief The position of the cursor.
+	 * @private
+	 */
+	size_t index;
+
+	/**
+	 * @brief The depth of the node stack, for Dictionaries which are trees.
+	 * @private
+	 */
+	size_t depth;
+
+	/**
+	 * @brief The node stack, for Dictionaries which are trees.
+	 * @private
+	 */
+	const void *nodes[DICTIONARY_ITERATOR_DEPTH];
+
+	/**
+	 * @brief The position of the cursor within each node of the stack.
+	 * @private
+	 */
+	unsigned positions[DICTIONARY_ITERATOR_DEPTH];
+} DictionaryIterator;
+
 /**
  * @brief Immutable key-value stores.
  * @extends Object
@@ -63,7 +124,7 @@ struct Dictionary {
 	DictionaryInterface *interface;
 
 	/**
-	 * @brief The internal size (number of bins).
+	 * @brief The internal size (number of slots), which is always zero or a power of two.
 	 * @private
 	 */
 	size_t capacity;
@@ -74,10 +135,32 @@ struct Dictionary {
 	size_t count;
 
 	/**
-	 * @brief The elements.
+	 * @brief The slots, which are kept in Robin Hood order: each entry is displaced from its
+	 * home slot by no more than the entry preceding it, plus one.
+	 * @private
+	 */
+	DictionaryEntry *entries;
+
+	/**
+	 * @brief The slots of the table being migrated from, or `NULL`.
+	 * @details After growing, entries are migrated from the previous table a few slots at a time,
+	 * so that no single mutation pays for rehashing the entire Dictionary. Slots which have been
+	 * migrated, or whose entries were removed before migration, have a `NULL` object.
+	 * @private
+	 */
+	DictionaryEntry *previousEntries;
+
+	/**
+	 * @brief The internal size of the table being migrated from.
 	 * @private
 	 */
-	ident *elements;
+	size_t previousCapacity;
+
+	/**
+	 * @brief The number of slots of the previous table which have been migrated.
+	 * @private
+	 */
+	size_t migrated;
 };
 
 typedef struct MutableDictionary MutableDictionary;
@@ -128,6 +211,17 @@ struct DictionaryInterface {
 	 */
 	Dictionary *(*dictionaryWithObjectsAndKeys)(ident obj, ...);
 
+	/**
+	 * @static
+	 * @fn Dictionary *Dictionary::dictionaryWithObjectsForKeys(const Array *objects, const Array *keys)
+	 * @brief Returns a new Dictionary containing the pairs of the given parallel Arrays.
+	 * @param objects The Objects.
+	 * @param keys The keys, which must be as many as `objects`.
+	 * @return The new Dictionary, or `NULL` on error.
+	 * @memberof Dictionary
+	 */
+	Dictionary *(*dictionaryWithObjectsForKeys)(const Array *objects, const Array *keys);
+
 	/**
 	 * @fn void Dictionary::enumerateObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator, ident data)
 	 * @brief Enumerate the pairs of this Dictionary with the given function.
@@ -169,6 +263,42 @@ struct DictionaryInterface {
 	 */
 	Dictionary *(*initWithObjectsAndKeys)(Dictionary *self, ...);
 
+	/**
+	 * @fn Dictionary *Dictionary::initWithObjectsForKeys(Dictionary *self, const Array *objects, const Array *keys)
+	 * @brief Initializes this Dictionary with the pairs of the given parallel Arrays.
+	 * @param self The Dictionary.
+	 * @param objects The Objects.
+	 * @param keys The keys, which must be as many as `objects`.
+	 * @return The initialized Dictionary, or `NULL` on error.
+	 * @see Dictionary::initWithObjectsForKeysCount(Dictionary *, const ident *, const ident *, size_t)
+	 * @memberof Dictionary
+	 */
+	Dictionary *(*initWithObjectsForKeys)(Dictionary *self, const Array *objects, const Array *keys);
+
+	/**
+	 * @fn Dictionary *Dictionary::initWithObjectsForKeysCount(Dictionary *self, const ident *objects, const ident *keys, size_t count)
+	 * @brief Initializes this Dictionary with the pairs of the given parallel C arrays.
+	 * @param self The Dictionary.
+	 * @param objects The Objects.
+	 * @param keys The keys.
+	 * @param count The number of Objects and keys.
+	 * @return The initialized Dictionary, or `NULL` on error.
+	 * @details The table is sized once for `count` pairs, the keys are hashed in a single pass,
+	 * and the pairs are then placed without any intermediate resizing. If a key is repeated, its
+	 * last Object is kept.
+	 * @memberof Dictionary
+	 */
+	Dictionary *(*initWithObjectsForKeysCount)(Dictionary *self, const ident *objects, const ident *keys, size_t count);
+
+	/**
+	 * @fn DictionaryIterator Dictionary::iterator(const Dictionary *self)
+	 * @param self The Dictionary.
+	 * @return A DictionaryIterator positioned before the first pair of this Dictionary.
+	 * @remarks Unlike `allKeys`, iteration allocates nothing, and yields each Object with its key.
+	 * @memberof Dictionary
+	 */
+	DictionaryIterator (*iterator)(const Dictionary *self);
+
 	/**
 	 * @fn MutableDictionary *Dictionary::mutableCopy(const Dictionary *self)
 	 * @param self The Dictionary.
@@ -177,6 +307,18 @@ struct DictionaryInterface {
 	 */
 	MutableDictionary *(*mutableCopy)(const Dictionary *self);
 
+	/**
+	 * @fn _Bool Dictionary::nextObjectAndKey(const Dictionary *self, DictionaryIterator *iterator, ident *obj, ident *key)
+	 * @brief Advances `iterator` to the next pair of this Dictionary.
+	 * @param self The Dictionary.
+	 * @param iterator The DictionaryIterator.
+	 * @param obj If not `NULL`, receives the Object of the next pair.
+	 * @param key If not `NULL`, receives the key of the next pair.
+	 * @return True if a pair was returned, false if iteration is complete.
+	 * @memberof Dictionary
+	 */
+	_Bool (*nextObjectAndKey)(const Dictionary *self, DictionaryIterator *iterator, ident *obj, ident *key);
+
 	/**
 	 * @fn ident Dictionary::objectForKey(const Dictionary *self, const ident key)
 	 * @param self The Dictionary.
@@ -203,3 +345,41 @@ struct DictionaryInterface {
  * @memberof Dictionary
  */
 OBJECTIVELY_EXPORT Class *_Dictionary(void);
+
+/**
+ * @brief Finds the slot for `key` in the given Dictionary table.
+ * @param entries The slots of the table.
+ * @param capacity The internal size of the table, which must be a power of two.
+ * @param hash The finalized hash of `key`.
+ * @param key The key.
+ * @return The index of the slot holding `key`, or `-1` if `key` is not present.
+ * @remarks Slots with a `NULL` object are probed past, but their keys are never compared.
+ * @private
+ */
+OBJECTIVELY_EXPORT ssize_t _dictionaryEntryIndex(const DictionaryEntry *entries, size_t capacity,
+		unsigned hash, const ident key);
+
+/**
+ * @brief Returns the Object for `key` in the given Dictionary's own table, given the key's hash.
+ * @param self The Dictionary, whose table must be the one defined by Dictionary.
+ * @param hash The finalized hash of `key`.
+ * @param key The key.
+ * @return The Object stored for `key`, or `NULL`.
+ * @remarks This allows callers which have already hashed `key` to avoid hashing it again.
+ * @private
+ */
+OBJECTIVELY_EXPORT ident _dictionaryObjectForKey(const Dictionary *self, unsigned hash, const ident key);
+
+/**
+ * @brief Places `entry` in the given Dictionary table, at or after slot `i`.
+ * @param entries The slots of the table.
+ * @param capacity The internal size of the table, which must be a power of two.
+ * @param entry The entry, whose key must not already be present.
+ * @param i The slot to begin probing at.
+ * @param distance The probe distance of slot `i` from the home slot of `entry`.
+ * @details Entries closer to their home slots than `entry` is to its own are displaced, and
+ * placed in turn.
+ * @private
+ */
+OBJECTIVELY_EXPORT void _dictionaryPlaceEntry(DictionaryEntry *entries, size_t capacity,
+		DictionaryEntry entry, size_t i, size_t distance);
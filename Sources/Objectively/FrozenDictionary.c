@@ -0,0 +1,548 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Objectively/FrozenDictionary.h>
+#include <Objectively/Hash.h>
+#include <Objectively/MutableDictionary.h>
+
+#define _Class _FrozenDictionary
+
+#define FROZENDICTIONARY_BUCKET_SIZE 4
+#define FROZENDICTIONARY_MAX_SEED 0xffff
+
+/**
+ * @brief Maps `hash` uniformly onto `[0, range)`, without division.
+ */
+static inline size_t reduce(unsigned hash, size_t range) {
+	return ((uint64_t) hash * range) >> 32;
+}
+
+/**
+ * @return The perfect hash slot for `hash`, under the given bucket `seed`.
+ */
+static inline size_t slotForSeed(unsigned hash, unsigned seed, size_t slots) {
+
+	unsigned h = hash ^ (seed * 0x9e3779b9u);
+
+	h ^= h >> 16;
+	h *= 0x85ebca6bu;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35u;
+	h ^= h >> 16;
+
+	return reduce(h, slots);
+}
+
+/**
+ * @return The pair for `key`, or `NULL` if `key` is not present.
+ */
+static const ident *pairForKey(const FrozenDictionary *self, const ident key) {
+
+	if (self->slots == 0) {
+		return NULL;
+	}
+
+	const unsigned hash = HashFinalize(HashForObject(HASH_SEED, key));
+	const unsigned seed = self->seeds[reduce(hash, self->buckets)];
+
+	const ident *pair = self->pairs + (slotForSeed(hash, seed, self->slots) << 1);
+
+	if (pair[0] && (pair[0] == key || $((Object *) pair[0], isEqual, key))) {
+		return pair;
+	}
+
+	if (self->collisionCount) {
+
+		size_t low = 0, high = self->collisionCount;
+		while (low < high) {
+			const size_t middle = (low + high) >> 1;
+			if (self->collisions[middle] < hash) {
+				low = middle + 1;
+			} else {
+				high = middle;
+			}
+		}
+
+		for (size_t i = low; i < self->collisionCount && self->collisions[i] == hash; i++) {
+
+			pair = self->pairs + ((self->slots + i) << 1);
+
+			if (pair[0] == key || $((Object *) pair[0], isEqual, key)) {
+				return pair;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+#pragma mark - Object
+
+/**
+ * @see Object::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	FrozenDictionary *that = (FrozenDictionary *) $((Object *) alloc(FrozenDictionary), init);
+	if (that && this->slots) {
+
+		const size_t length = (this->slots + this->collisionCount) << 1;
+
+		that->pairs = calloc(length, sizeof(ident));
+		assert(that->pairs);
+
+		for (size_t i = 0; i < length; i += 2) {
+			if (this->pairs[i]) {
+				that->pairs[i + 0] = retain(this->pairs[i + 0]);
+				that->pairs[i + 1] = retain(this->pairs[i + 1]);
+			}
+		}
+
+		that->seeds = malloc(this->buckets * sizeof(uint16_t));
+		assert(that->seeds);
+
+		memcpy(that->seeds, this->seeds, this->buckets * sizeof(uint16_t));
+
+		if (this->collisionCount) {
+			that->collisions = malloc(this->collisionCount * sizeof(unsigned));
+			assert(that->collisions);
+
+			memcpy(that->collisions, this->collisions, this->collisionCount * sizeof(unsigned));
+		}
+
+		that->slots = this->slots;
+		that->buckets = this->buckets;
+		that->collisionCount = this->collisionCount;
+		that->dictionary.count = this->dictionary.count;
+	}
+
+	return (Object *) that;
+}
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	FrozenDictionary *this = (FrozenDictionary *) self;
+
+	const size_t length = (this->slots + this->collisionCount) << 1;
+
+	for (size_t i = 0; i < length; i++) {
+		release(this->pairs[i]);
+	}
+
+	free(this->pairs);
+	free(this->seeds);
+	free(this->collisions);
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - Dictionary
+
+/**
+ * @see Dictionary::enumerateObjectsAndKeys(const Dictionary *, DictionaryEnumerator, ident)
+ */
+static void enumerateObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		ident data) {
+
+	assert(enumerator);
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	for (size_t i = 0; i < this->slots + this->collisionCount; i++) {
+
+		const ident *pair = this->pairs + (i << 1);
+
+		if (pair[0] && enumerator(self, pair[1], pair[0], data)) {
+			return;
+		}
+	}
+}
+
+/**
+ * @see Dictionary::filterObjectsAndKeys(const Dictionary *, DictionaryEnumerator, ident)
+ */
+static Dictionary *filterObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		ident data) {
+
+	assert(enumerator);
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	MutableDictionary *dictionary = $(alloc(MutableDictionary), init);
+
+	for (size_t i = 0; i < this->slots + this->collisionCount; i++) {
+
+		const ident *pair = this->pairs + (i << 1);
+
+		if (pair[0] && enumerator(self, pair[1], pair[0], data)) {
+			$(dictionary, setObjectForKey, pair[1], pair[0]);
+		}
+	}
+
+	return (Dictionary *) dictionary;
+}
+
+/**
+ * @brief A key to be assigned a perfect hash slot.
+ */
+typedef struct {
+	unsigned hash;
+	size_t entry;
+	size_t bucket;
+	size_t slot;
+} FrozenDictionaryKey;
+
+/**
+ * @brief Gathers the pairs of a Dictionary, for initWithDictionary.
+ */
+typedef struct {
+	DictionaryEntry *entries;
+	size_t count;
+} FrozenDictionaryGather;
+
+/**
+ * @brief A DictionaryEnumerator for initWithDictionary.
+ */
+static _Bool initWithDictionary_enumerator(const Dictionary *dict, ident obj, ident key, ident data) {
+
+	FrozenDictionaryGather *gather = (FrozenDictionaryGather *) data;
+
+	gather->entries[gather->count++] = (DictionaryEntry) {
+		.key = retain(key),
+		.object = retain(obj),
+		.hash = HashFinalize(HashForObject(HASH_SEED, key))
+	};
+
+	return false;
+}
+
+/**
+ * @brief qsort comparator for DictionaryEntry, by hash.
+ */
+static int initWithDictionary_compareEntries(const void *a, const void *b) {
+
+	const unsigned x = ((const DictionaryEntry *) a)->hash;
+	const unsigned y = ((const DictionaryEntry *) b)->hash;
+
+	return x < y ? -1 : x > y;
+}
+
+/**
+ * @brief Searches for a seed for each bucket, so that every key has a distinct slot.
+ * @details Buckets are seeded largest first, while most slots are still free. Because there are
+ * more slots than keys, even the last buckets find a free slot within a few attempts.
+ * @return True if every bucket was seeded, false if `buckets` should be increased.
+ */
+static _Bool initWithDictionary_seed(FrozenDictionary *self, FrozenDictionaryKey *keys, size_t count) {
+
+	const size_t slots = self->slots, buckets = self->buckets;
+
+	size_t *sizes = calloc(buckets, sizeof(size_t));
+	size_t *firsts = calloc(buckets + 1, sizeof(size_t));
+	FrozenDictionaryKey **members = calloc(count, sizeof(FrozenDictionaryKey *));
+	size_t *order = calloc(buckets, sizeof(size_t));
+	_Bool *taken = calloc(slots, sizeof(_Bool));
+
+	assert(sizes && firsts && members && order && taken);
+
+	size_t largest = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		keys[i].bucket = reduce(keys[i].hash, buckets);
+		largest = max(largest, ++sizes[keys[i].bucket]);
+	}
+
+	for (size_t b = 0; b < buckets; b++) {
+		firsts[b + 1] = firsts[b] + sizes[b];
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		members[firsts[keys[i].bucket] + --sizes[keys[i].bucket]] = &keys[i];
+	}
+
+	size_t ordered = 0;
+	for (size_t size = largest; size > 0; size--) {
+		for (size_t b = 0; b < buckets; b++) {
+			if (firsts[b + 1] - firsts[b] == size) {
+				order[ordered++] = b;
+			}
+		}
+	}
+
+	_Bool seeded = true;
+
+	for (size_t i = 0; i < ordered && seeded; i++) {
+
+		const size_t b = order[i];
+		FrozenDictionaryKey **bucket = members + firsts[b];
+		const size_t size = firsts[b + 1] - firsts[b];
+
+		seeded = false;
+
+		for (unsigned seed = 0; seed <= FROZENDICTIONARY_MAX_SEED && !seeded; seed++) {
+
+			size_t j;
+			for (j = 0; j < size; j++) {
+
+				bucket[j]->slot = slotForSeed(bucket[j]->hash, seed, slots);
+				if (taken[bucket[j]->slot]) {
+					break;
+				}
+
+				taken[bucket[j]->slot] = true;
+			}
+
+			if (j == size) {
+				self->seeds[b] = (uint16_t) seed;
+				seeded = true;
+			} else {
+				while (j--) {
+					taken[bucket[j]->slot] = false;
+				}
+			}
+		}
+	}
+
+	free(sizes);
+	free(firsts);
+	free(members);
+	free(order);
+	free(taken);
+
+	return seeded;
+}
+
+/**
+ * @see Dictionary::initWithDictionary(Dictionary *, const Dictionary *)
+ */
+static Dictionary *initWithDictionary(Dictionary *self, const Dictionary *dictionary) {
+
+	self = (Dictionary *) super(Object, self, init);
+	if (self) {
+		if (dictionary && dictionary->count) {
+
+			FrozenDictionary *this = (FrozenDictionary *) self;
+
+			FrozenDictionaryGather gather = {
+				.entries = calloc(dictionary->count, sizeof(DictionaryEntry))
+			};
+			assert(gather.entries);
+
+			$(dictionary, enumerateObjectsAndKeys, initWithDictionary_enumerator, &gather);
+
+			DictionaryEntry *entries = gather.entries;
+			const size_t count = gather.count;
+
+			qsort(entries, count, sizeof(DictionaryEntry), initWithDictionary_compareEntries);
+
+			FrozenDictionaryKey *keys = calloc(count, sizeof(FrozenDictionaryKey));
+			assert(keys);
+
+			size_t distinct = 0;
+			for (size_t i = 0; i < count; i++) {
+				if (i == 0 || entries[i].hash != entries[i - 1].hash) {
+					keys[distinct++] = (FrozenDictionaryKey) {
+						.hash = entries[i].hash,
+						.entry = i
+					};
+				}
+			}
+
+			this->slots = distinct + (distinct >> 4) + 1;
+			this->buckets = max((size_t) 1, distinct / FROZENDICTIONARY_BUCKET_SIZE);
+
+			while (true) {
+
+				this->seeds = calloc(this->buckets, sizeof(uint16_t));
+				assert(this->seeds);
+
+				if (initWithDictionary_seed(this, keys, distinct)) {
+					break;
+				}
+
+				free(this->seeds);
+				this->buckets <<= 1;
+			}
+
+			this->collisionCount = count - distinct;
+
+			this->pairs = calloc((this->slots + this->collisionCount) << 1, sizeof(ident));
+			assert(this->pairs);
+
+			for (size_t i = 0; i < distinct; i++) {
+
+				const DictionaryEntry *entry = &entries[keys[i].entry];
+
+				this->pairs[(keys[i].slot << 1) + 0] = entry->key;
+				this->pairs[(keys[i].slot << 1) + 1] = entry->object;
+			}
+
+			if (this->collisionCount) {
+
+				this->collisions = calloc(this->collisionCount, sizeof(unsigned));
+				assert(this->collisions);
+
+				size_t c = 0;
+				for (size_t i = 1; i < count; i++) {
+					if (entries[i].hash == entries[i - 1].hash) {
+
+						this->collisions[c] = entries[i].hash;
+
+						this->pairs[((this->slots + c) << 1) + 0] = entries[i].key;
+						this->pairs[((this->slots + c) << 1) + 1] = entries[i].object;
+
+						c++;
+					}
+				}
+			}
+
+			self->count = count;
+
+			free(keys);
+			free(entries);
+		}
+	}
+
+	return self;
+}
+
+/**
+ * @see Dictionary::initWithObjectsForKeysCount(Dictionary *, const ident *, const ident *, size_t)
+ */
+static Dictionary *initWithObjectsForKeysCount(Dictionary *self, const ident *objects, const ident *keys, size_t count) {
+
+	Dictionary *dictionary = $(alloc(Dictionary), initWithObjectsForKeysCount, objects, keys, count);
+
+	self = $(self, initWithDictionary, dictionary);
+
+	release(dictionary);
+
+	return self;
+}
+
+/**
+ * @see Dictionary::nextObjectAndKey(const Dictionary *, DictionaryIterator *, ident *, ident *)
+ */
+static _Bool nextObjectAndKey(const Dictionary *self, DictionaryIterator *iterator, ident *obj, ident *key) {
+
+	assert(iterator);
+
+	const FrozenDictionary *this = (FrozenDictionary *) self;
+
+	while (iterator->index < this->slots + this->collisionCount) {
+
+		const ident *pair = this->pairs + (iterator->index++ << 1);
+		if (pair[0]) {
+
+			if (obj) {
+				*obj = pair[1];
+			}
+			if (key) {
+				*key = pair[0];
+			}
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @see Dictionary::objectForKey(const Dictionary *, const ident)
+ */
+static ident objectForKey(const Dictionary *self, const ident key) {
+
+	const ident *pair = pairForKey((FrozenDictionary *) self, key);
+
+	return pair ? pair[1] : NULL;
+}
+
+#pragma mark - FrozenDictionary
+
+/**
+ * @fn FrozenDictionary *FrozenDictionary::dictionaryWithDictionary(const Dictionary *dictionary)
+ * @memberof FrozenDictionary
+ */
+static FrozenDictionary *dictionaryWithDictionary(const Dictionary *dictionary) {
+
+	return (FrozenDictionary *) $((Dictionary *) alloc(FrozenDictionary), initWithDictionary, dictionary);
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	ObjectInterface *object = (ObjectInterface *) clazz->def->interface;
+
+	object->copy = copy;
+	object->dealloc = dealloc;
+
+	DictionaryInterface *dictionary = (DictionaryInterface *) clazz->def->interface;
+
+	dictionary->enumerateObjectsAndKeys = enumerateObjectsAndKeys;
+	dictionary->filterObjectsAndKeys = filterObjectsAndKeys;
+	dictionary->initWithDictionary = initWithDictionary;
+	dictionary->initWithObjectsForKeysCount = initWithObjectsForKeysCount;
+	dictionary->nextObjectAndKey = nextObjectAndKey;
+	dictionary->objectForKey = objectForKey;
+
+	FrozenDictionaryInterface *frozenDictionary = (FrozenDictionaryInterface *) clazz->def->interface;
+
+	frozenDictionary->dictionaryWithDictionary = dictionaryWithDictionary;
+}
+
+/**
+ * @fn Class *FrozenDictionary::_FrozenDictionary(void)
+ * @memberof FrozenDictionary
+ */
+Class *_FrozenDictionary(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "FrozenDictionary";
+		clazz.superclass = _Dictionary();
+		clazz.instanceSize = sizeof(FrozenDictionary);
+		clazz.interfaceOffset = offsetof(FrozenDictionary, interface);
+		clazz.interfaceSize = sizeof(FrozenDictionaryInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
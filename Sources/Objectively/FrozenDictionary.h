@@ -0,0 +1,127 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#pragma once
+
+#include <Objectively/Dictionary.h>
+
+/**
+ * @file
+ * @brief Immutable key-value stores, built once for fast lookup.
+ */
+
+typedef struct FrozenDictionary FrozenDictionary;
+typedef struct FrozenDictionaryInterface FrozenDictionaryInterface;
+
+/**
+ * @brief Immutable key-value stores, built once for fast lookup.
+ * @details FrozenDictionary stores its keys and Objects as pairs in a single array, indexed by a
+ * perfect hash of its keys. A small array of per-bucket seeds selects each key's slot. Each lookup
+ * hashes the key once, reads its bucket's seed, and compares the key in the single slot it
+ * addresses. This costs little more than two words per pair, and makes FrozenDictionary well
+ * suited to lookup tables which are built at startup and then only read.
+ * @remarks Keys whose hashes collide with another key's are stored apart, ordered by hash, and are
+ * searched only when the perfect hash slot does not match.
+ * @extends Dictionary
+ * @ingroup Collections
+ */
+struct FrozenDictionary {
+
+	/**
+	 * @brief The superclass.
+	 */
+	Dictionary dictionary;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	FrozenDictionaryInterface *interface;
+
+	/**
+	 * @brief The keys and Objects, interleaved: first the perfect hash slots, and then the
+	 * colliding pairs. Unoccupied slots have a `NULL` key.
+	 * @private
+	 */
+	ident *pairs;
+
+	/**
+	 * @brief The number of perfect hash slots.
+	 * @private
+	 */
+	size_t slots;
+
+	/**
+	 * @brief The seed of each bucket of keys.
+	 * @private
+	 */
+	uint16_t *seeds;
+
+	/**
+	 * @brief The number of buckets.
+	 * @private
+	 */
+	size_t buckets;
+
+	/**
+	 * @brief The hashes of the colliding pairs, in ascending order, or `NULL`.
+	 * @private
+	 */
+	unsigned *collisions;
+
+	/**
+	 * @brief The number of colliding pairs.
+	 * @private
+	 */
+	size_t collisionCount;
+};
+
+/**
+ * @brief The FrozenDictionary interface.
+ */
+struct FrozenDictionaryInterface {
+
+	/**
+	 * @brief The superclass.
+	 */
+	DictionaryInterface dictionaryInterface;
+
+	/**
+	 * @static
+	 * @fn FrozenDictionary *FrozenDictionary::dictionaryWithDictionary(const Dictionary *dictionary)
+	 * @brief Returns a new FrozenDictionary containing the entries of `dictionary`.
+	 * @param dictionary A Dictionary.
+	 * @return The new FrozenDictionary, or `NULL` on error.
+	 * @memberof FrozenDictionary
+	 */
+	FrozenDictionary *(*dictionaryWithDictionary)(const Dictionary *dictionary);
+};
+
+/**
+ * @fn Class *FrozenDictionary::_FrozenDictionary(void)
+ * @brief The FrozenDictionary archetype.
+ * @return The FrozenDictionary Class.
+ * @memberof FrozenDictionary
+ */
+OBJECTIVELY_EXPORT Class *_FrozenDictionary(void);
@@ -21,25 +21,135 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include <Objectively/Hash.h>
+#include <Objectively/Once.h>
+
+/**
+ * @brief The secrets mixed into HashForBytes64.
+ */
+#define HASH_P0 0xa0761d6478bd642full
+#define HASH_P1 0xe7037ed1a0b428dbull
+#define HASH_P2 0x8ebc6af09c88c6e3ull
+#define HASH_P3 0x589965cc75374cc3ull
+
+/**
+ * @brief Multiplies `*a` by `*b`, storing the low and high halves of the product in `a` and `b`.
+ */
+static inline void multiply(uint64_t *a, uint64_t *b) {
+
+#if defined(__SIZEOF_INT128__)
+	const __uint128_t r = (__uint128_t) *a * *b;
+
+	*a = (uint64_t) r;
+	*b = (uint64_t) (r >> 64);
+#else
+	const uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t) *a, lb = (uint32_t) *b;
+	const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+	const uint64_t t = rl + (rm0 << 32), lo = t + (rm1 << 32);
+	const uint64_t c = (t < rl) + (lo < t);
+
+	*a = lo;
+	*b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+/**
+ * @return The halves of the product of `a` and `b`, folded together.
+ */
+static inline uint64_t mix(uint64_t a, uint64_t b) {
+
+	multiply(&a, &b);
+
+	return a ^ b;
+}
+
+/**
+ * @return The unaligned 64 bit word at `p`.
+ */
+static inline uint64_t read64(const uint8_t *p) {
+
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
+
+	return v;
+}
+
+/**
+ * @return The unaligned 32 bit word at `p`.
+ */
+static inline uint64_t read32(const uint8_t *p) {
+
+	uint32_t v;
+	memcpy(&v, p, sizeof(v));
+
+	return v;
+}
 
 int HashForBytes(int hash, const uint8_t *bytes, const Range range) {
 
-	for (size_t i = range.location; i < range.length; i++) {
+	const uint64_t h = HashForBytes64(HashSeed() ^ (unsigned) hash, bytes + range.location, range.length);
+
+	return (int) (uint32_t) (h ^ (h >> 32));
+}
+
+uint64_t HashForBytes64(uint64_t seed, const uint8_t *bytes, size_t length) {
+
+	const uint8_t *p = bytes;
+	uint64_t a, b;
 
-		int shift;
-		if (i & 1) {
-			shift = 16 + (i % 16);
+	seed ^= mix(seed ^ HASH_P0, HASH_P1);
+
+	if (length <= 16) {
+		if (length >= 4) {
+			const size_t k = (length >> 3) << 2;
+
+			a = (read32(p) << 32) | read32(p + k);
+			b = (read32(p + length - 4) << 32) | read32(p + length - 4 - k);
+		} else if (length > 0) {
+			a = ((uint64_t) p[0] << 16) | ((uint64_t) p[length >> 1] << 8) | p[length - 1];
+			b = 0;
 		} else {
-			shift = (i % 16);
+			a = b = 0;
+		}
+	} else {
+		size_t i = length;
+
+		if (i > 48) {
+			uint64_t seed1 = seed, seed2 = seed;
+
+			do {
+				seed = mix(read64(p) ^ HASH_P1, read64(p + 8) ^ seed);
+				seed1 = mix(read64(p + 16) ^ HASH_P2, read64(p + 24) ^ seed1);
+				seed2 = mix(read64(p + 32) ^ HASH_P3, read64(p + 40) ^ seed2);
+
+				p += 48;
+				i -= 48;
+			} while (i > 48);
+
+			seed ^= seed1 ^ seed2;
+		}
+
+		while (i > 16) {
+			seed = mix(read64(p) ^ HASH_P1, read64(p + 8) ^ seed);
+
+			p += 16;
+			i -= 16;
 		}
 
-		hash += 31 * ((int) bytes[i]) << shift;
+		a = read64(p + i - 16);
+		b = read64(p + i - 8);
 	}
 
-	return hash;
+	a ^= HASH_P1;
+	b ^= seed;
+
+	multiply(&a, &b);
+
+	return mix(a ^ HASH_P0 ^ length, b ^ HASH_P1);
 }
 
 int HashForCharacters(int hash, const char *chars, const Range range) {
@@ -55,19 +165,45 @@ int HashForCString(int hash, const char *string) {
 
 int HashForDecimal(int hash, const double decimal) {
 
-	return hash + 31 * (int) decimal;
+	return (int) ((unsigned) hash + 31u * (unsigned) (int) decimal);
+}
+
+unsigned HashFinalize(int hash) {
+
+	const uint64_t h = mix((unsigned) hash ^ HashSeed(), HASH_P1);
+
+	return (unsigned) (h ^ (h >> 32));
 }
 
 int HashForInteger(int hash, const long integer) {
 
-	return hash + 31 * (int) integer;
+	return (int) ((unsigned) hash + 31u * (unsigned) integer);
 }
 
 int HashForObject(int hash, const ident obj) {
 
 	if (obj) {
-		return hash + 31 * $(cast(Object, obj), hash);
+		return (int) ((unsigned) hash + 31u * (unsigned) $(cast(Object, obj), hash));
 	}
 
 	return 0;
 }
+
+uint64_t HashSeed(void) {
+	static uint64_t seed;
+	static Once once;
+
+	do_once(&once, {
+		const char *env = getenv(HASH_SEED_ENV);
+		if (env) {
+			seed = strtoull(env, NULL, 0);
+		} else {
+			int local;
+
+			seed = mix((uint64_t) time(NULL) ^ HASH_P2, (uint64_t) clock() ^ HASH_P3);
+			seed = mix(seed ^ (uintptr_t) &local, (uint64_t) (uintptr_t) &seed ^ HASH_P0);
+		}
+	});
+
+	return seed;
+}
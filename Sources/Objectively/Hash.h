@@ -36,15 +36,33 @@
  */
 #define HASH_SEED 13
 
+/**
+ * @brief The environment variable which, if set, overrides the per-process hash seed.
+ * @remarks This is useful for reproducing the iteration order of hashed collections.
+ */
+#define HASH_SEED_ENV "OBJECTIVELY_HASH_SEED"
+
 /**
  * @brief Accumulates the hash value of `bytes` into `hash`.
  * @param hash The hash accumulator.
  * @param bytes The bytes to hash.
  * @param range The Range to hash.
  * @return The accumulated hash value.
+ * @remarks This folds HashForBytes64, seeded with `hash` and the per-process seed, to 32 bits.
  */
 OBJECTIVELY_EXPORT int HashForBytes(int hash, const uint8_t *bytes, const Range range);
 
+/**
+ * @brief Calculates the 64 bit hash value of `length` of `bytes`.
+ * @param seed The seed.
+ * @param bytes The bytes to hash.
+ * @param length The length of `bytes`.
+ * @return The hash value.
+ * @remarks The input is consumed a word at a time, and mixed with 64 x 64 -> 128 bit multiplies.
+ * The result depends on the byte order of the host, and so should not be persisted.
+ */
+OBJECTIVELY_EXPORT uint64_t HashForBytes64(uint64_t seed, const uint8_t *bytes, size_t length);
+
 /**
  * @brief Accumulates the hash value of `chars` into `hash`.
  * @param hash The hash accumulator.
@@ -70,6 +88,16 @@ OBJECTIVELY_EXPORT int HashForCString(int hash, const char *chars);
  */
 OBJECTIVELY_EXPORT int HashForDecimal(int hash, const double decimal);
 
+/**
+ * @brief Finalizes `hash`, mixing all of its bits into its low bits.
+ * @param hash The hash accumulator.
+ * @return The finalized hash value, suitable for indexing a power-of-two table.
+ * @remarks The accumulators above are additive, and so their low bits are poorly distributed.
+ * The finalized value is keyed by the per-process seed, so that table placement can not be
+ * predicted from outside of the process.
+ */
+OBJECTIVELY_EXPORT unsigned HashFinalize(int hash);
+
 /**
  * @brief Accumulates the hash value of `integer` into `hash`.
  * @param hash The hash accumulator.
@@ -85,3 +113,9 @@ OBJECTIVELY_EXPORT int HashForInteger(int hash, const long integer);
  * @return The accumulated hash value.
  */
 OBJECTIVELY_EXPORT int HashForObject(int hash, const ident obj);
+
+/**
+ * @return The per-process hash seed.
+ * @remarks The seed is chosen at random when first requested, unless HASH_SEED_ENV is set.
+ */
+OBJECTIVELY_EXPORT uint64_t HashSeed(void);
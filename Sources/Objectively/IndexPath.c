@@ -80,15 +80,20 @@ static String *description(const Object *self) {
  */
 static int hash(const Object *self) {
 
-	int hash = HASH_SEED;
+	IndexPath *this = (IndexPath *) self;
 
-	const IndexPath *this = (IndexPath *) self;
+	if (this->hash == 0) {
 
-	for (size_t i = 0; i < this->length; i++) {
-		hash = HashForInteger(hash, this->indexes[i]);
+		int hash = HASH_SEED;
+
+		for (size_t i = 0; i < this->length; i++) {
+			hash = HashForInteger(hash, this->indexes[i]);
+		}
+
+		this->hash = hash;
 	}
 
-	return hash;
+	return this->hash;
 }
 
 /**
@@ -59,6 +59,12 @@ struct IndexPath {
 	 * @brief The length of `indexes`.
 	 */
 	size_t length;
+
+	/**
+	 * @brief The hash, computed lazily, or `0` if it has not yet been computed.
+	 * @private
+	 */
+	int hash;
 };
 
 /**
@@ -0,0 +1,566 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+
+#include <Objectively/Hash.h>
+#include <Objectively/IndexedArray.h>
+
+#define _Class _IndexedArray
+
+#define INDEXEDARRAY_MIN_INDEX_CAPACITY 8
+
+struct IndexedArrayEntry {
+
+	/**
+	 * @brief The position of the first occurrence of the Object.
+	 */
+	size_t index;
+
+	/**
+	 * @brief The number of occurrences of the Object, or `0` if this slot is empty.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The finalized hash of the Object.
+	 */
+	unsigned hash;
+};
+
+/**
+ * @return The finalized hash of `obj`.
+ */
+static inline unsigned hashForObject(const ident obj) {
+	return HashFinalize(HashForObject(HASH_SEED, obj));
+}
+
+/**
+ * @brief Probes the index for `obj`.
+ * @return The slot holding `obj`, or the empty slot at which it would be inserted.
+ */
+static size_t slotForObject(const IndexedArray *self, const ident obj, unsigned hash, _Bool *found) {
+
+	const size_t mask = self->indexCapacity - 1;
+	const Array *array = (Array *) self;
+
+	size_t i = hash & mask;
+	for (; self->entries[i].count; i = (i + 1) & mask) {
+
+		const IndexedArrayEntry *entry = &self->entries[i];
+		if (entry->hash == hash) {
+
+			const ident element = array->elements[entry->index];
+			if (element == obj || $((Object *) obj, isEqual, (Object *) element)) {
+				*found = true;
+				return i;
+			}
+		}
+	}
+
+	*found = false;
+	return i;
+}
+
+/**
+ * @brief Resizes the index to `capacity` slots, which must be a power of two.
+ */
+static void resizeIndex(IndexedArray *self, size_t capacity) {
+
+	IndexedArrayEntry *entries = self->entries;
+	const size_t oldCapacity = self->indexCapacity;
+
+	self->entries = calloc(capacity, sizeof(IndexedArrayEntry));
+	assert(self->entries);
+
+	self->indexCapacity = capacity;
+
+	const size_t mask = capacity - 1;
+
+	for (size_t i = 0; i < oldCapacity; i++) {
+		if (entries[i].count) {
+
+			size_t j = entries[i].hash & mask;
+			while (self->entries[j].count) {
+				j = (j + 1) & mask;
+			}
+
+			self->entries[j] = entries[i];
+		}
+	}
+
+	free(entries);
+}
+
+/**
+ * @brief Records an occurrence of `obj` at `index`.
+ */
+static void addToIndex(IndexedArray *self, const ident obj, size_t index) {
+
+	if ((self->indexCount + 1) * 2 > self->indexCapacity) {
+		resizeIndex(self, max(self->indexCapacity << 1, (size_t) INDEXEDARRAY_MIN_INDEX_CAPACITY));
+	}
+
+	const unsigned hash = hashForObject(obj);
+
+	_Bool found;
+	const size_t i = slotForObject(self, obj, hash, &found);
+
+	if (found) {
+		self->entries[i].count++;
+		self->entries[i].index = min(self->entries[i].index, index);
+	} else {
+		self->entries[i] = (IndexedArrayEntry) {
+			.index = index,
+			.count = 1,
+			.hash = hash
+		};
+		self->indexCount++;
+	}
+}
+
+/**
+ * @brief Builds the index, if it has not been built.
+ */
+static void buildIndex(IndexedArray *self) {
+
+	if (self->entries == NULL) {
+
+		const Array *array = (Array *) self;
+
+		size_t capacity = INDEXEDARRAY_MIN_INDEX_CAPACITY;
+		while (capacity < array->count * 2) {
+			capacity <<= 1;
+		}
+
+		resizeIndex(self, capacity);
+
+		for (size_t i = 0; i < array->count; i++) {
+			addToIndex(self, array->elements[i], i);
+		}
+	}
+}
+
+/**
+ * @brief Discards the index, to be rebuilt on the next lookup.
+ */
+static void invalidateIndex(IndexedArray *self) {
+
+	free(self->entries);
+
+	self->entries = NULL;
+	self->indexCount = self->indexCapacity = 0;
+}
+
+/**
+ * @brief Removes the entry at `slot` from the index, shifting following entries back towards
+ * their home slots, so that no tombstone is needed.
+ */
+static void removeFromIndex(IndexedArray *self, size_t slot) {
+
+	const size_t mask = self->indexCapacity - 1;
+
+	size_t i = slot;
+	for (size_t j = (i + 1) & mask; self->entries[j].count; j = (j + 1) & mask) {
+
+		const size_t home = self->entries[j].hash & mask;
+
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			self->entries[i] = self->entries[j];
+			i = j;
+		}
+	}
+
+	self->entries[i].count = 0;
+	self->indexCount--;
+}
+
+/**
+ * @brief Adds `delta` to the positions of all entries at or beyond `index`.
+ */
+static void shiftIndex(IndexedArray *self, size_t index, ssize_t delta) {
+
+	for (size_t i = 0; i < self->indexCapacity; i++) {
+
+		IndexedArrayEntry *entry = &self->entries[i];
+		if (entry->count && entry->index >= index) {
+			entry->index += delta;
+		}
+	}
+}
+
+#pragma mark - Object
+
+/**
+ * @see Object::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+
+	const Array *this = (Array *) self;
+
+	IndexedArray *that = $(alloc(IndexedArray), initWithCapacity, this->count);
+
+	$((MutableArray *) that, addObjectsFromArray, this);
+
+	return (Object *) that;
+}
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	IndexedArray *this = (IndexedArray *) self;
+
+	free(this->entries);
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - Array
+
+/**
+ * @see Array::indexOfObject(const Array *, const ident)
+ */
+static ssize_t indexOfObject(const Array *self, const ident obj) {
+
+	assert(obj);
+
+	IndexedArray *this = (IndexedArray *) self;
+
+	buildIndex(this);
+
+	_Bool found;
+	const size_t i = slotForObject(this, obj, hashForObject(obj), &found);
+
+	return found ? (ssize_t) this->entries[i].index : -1;
+}
+
+#pragma mark - MutableArray
+
+/**
+ * @see MutableArray::addObject(MutableArray *, const ident)
+ */
+static void addObject(MutableArray *self, const ident obj) {
+
+	super(MutableArray, self, addObject, obj);
+
+	IndexedArray *this = (IndexedArray *) self;
+	if (this->entries) {
+		addToIndex(this, obj, self->array.count - 1);
+	}
+}
+
+/**
+ * @see MutableArray::addObjectsFromArray(MutableArray *, const Array *)
+ */
+static void addObjectsFromArray(MutableArray *self, const Array *array) {
+
+	const size_t count = self->array.count;
+
+	super(MutableArray, self, addObjectsFromArray, array);
+
+	IndexedArray *this = (IndexedArray *) self;
+	if (this->entries) {
+		for (size_t i = count; i < self->array.count; i++) {
+			addToIndex(this, self->array.elements[i], i);
+		}
+	}
+}
+
+/**
+ * @see MutableArray::filter(MutableArray *, Predicate, ident)
+ */
+static void filter(MutableArray *self, Predicate predicate, ident data) {
+
+	super(MutableArray, self, filter, predicate, data);
+
+	invalidateIndex((IndexedArray *) self);
+}
+
+/**
+ * @fn IndexedArray *IndexedArray::array(void)
+ * @memberof IndexedArray
+ */
+static IndexedArray *array(void) {
+
+	return $(alloc(IndexedArray), init);
+}
+
+/**
+ * @fn IndexedArray *IndexedArray::arrayWithCapacity(size_t capacity)
+ * @memberof IndexedArray
+ */
+static IndexedArray *arrayWithCapacity(size_t capacity) {
+
+	return $(alloc(IndexedArray), initWithCapacity, capacity);
+}
+
+/**
+ * @fn IndexedArray *IndexedArray::init(IndexedArray *self)
+ * @memberof IndexedArray
+ */
+static IndexedArray *init(IndexedArray *self) {
+
+	return $(self, initWithCapacity, 0);
+}
+
+/**
+ * @fn IndexedArray *IndexedArray::initWithCapacity(IndexedArray *self, size_t capacity)
+ * @memberof IndexedArray
+ */
+static IndexedArray *initWithCapacity(IndexedArray *self, size_t capacity) {
+
+	return (IndexedArray *) super(MutableArray, self, initWithCapacity, capacity);
+}
+
+/**
+ * @see MutableArray::insertObjectAtIndex(MutableArray *, ident, size_t)
+ */
+static void insertObjectAtIndex(MutableArray *self, ident obj, size_t index) {
+
+	super(MutableArray, self, insertObjectAtIndex, obj, index);
+
+	IndexedArray *this = (IndexedArray *) self;
+	if (this->entries) {
+
+		shiftIndex(this, index, 1);
+		addToIndex(this, obj, index);
+	}
+}
+
+/**
+ * @see MutableArray::removeAllObjects(MutableArray *)
+ */
+static void removeAllObjects(MutableArray *self) {
+
+	super(MutableArray, self, removeAllObjects);
+
+	invalidateIndex((IndexedArray *) self);
+}
+
+/**
+ * @see MutableArray::removeObjectAtIndex(MutableArray *, size_t)
+ */
+static void removeObjectAtIndex(MutableArray *self, size_t index) {
+
+	IndexedArray *this = (IndexedArray *) self;
+
+	if (this->entries == NULL) {
+		super(MutableArray, self, removeObjectAtIndex, index);
+		return;
+	}
+
+	assert(index < self->array.count);
+
+	const ident obj = retain(self->array.elements[index]);
+
+	_Bool found;
+	const size_t i = slotForObject(this, obj, hashForObject(obj), &found);
+
+	assert(found);
+
+	super(MutableArray, self, removeObjectAtIndex, index);
+
+	IndexedArrayEntry *entry = &this->entries[i];
+
+	if (entry->count == 1) {
+		shiftIndex(this, index + 1, -1);
+		removeFromIndex(this, i);
+	} else {
+		entry->count--;
+
+		if (entry->index == index) {
+			for (size_t j = index; j < self->array.count; j++) {
+				if ($((Object *) obj, isEqual, (Object *) self->array.elements[j])) {
+					entry->index = j + 1;
+					break;
+				}
+			}
+		}
+
+		shiftIndex(this, index + 1, -1);
+	}
+
+	release(obj);
+}
+
+/**
+ * @see MutableArray::removeObjectsAtIndexes(MutableArray *, const IndexSet *)
+ */
+static void removeObjectsAtIndexes(MutableArray *self, const IndexSet *indexes) {
+
+	super(MutableArray, self, removeObjectsAtIndexes, indexes);
+
+	invalidateIndex((IndexedArray *) self);
+}
+
+/**
+ * @see MutableArray::removeObjectsInRange(MutableArray *, const Range)
+ */
+static void removeObjectsInRange(MutableArray *self, const Range range) {
+
+	super(MutableArray, self, removeObjectsInRange, range);
+
+	invalidateIndex((IndexedArray *) self);
+}
+
+/**
+ * @see MutableArray::setObjectAtIndex(MutableArray *, const ident, size_t)
+ */
+static void setObjectAtIndex(MutableArray *self, const ident obj, size_t index) {
+
+	IndexedArray *this = (IndexedArray *) self;
+
+	if (this->entries == NULL) {
+		super(MutableArray, self, setObjectAtIndex, obj, index);
+		return;
+	}
+
+	assert(index < self->array.count);
+
+	const ident old = retain(self->array.elements[index]);
+
+	_Bool found;
+	const size_t i = slotForObject(this, old, hashForObject(old), &found);
+	assert(found);
+
+	super(MutableArray, self, setObjectAtIndex, obj, index);
+
+	IndexedArrayEntry *entry = &this->entries[i];
+
+	if (entry->count == 1) {
+		removeFromIndex(this, i);
+	} else {
+		entry->count--;
+
+		if (entry->index == index) {
+			for (size_t j = index + 1; j < self->array.count; j++) {
+				if ($((Object *) old, isEqual, (Object *) self->array.elements[j])) {
+					entry->index = j;
+					break;
+				}
+			}
+		}
+	}
+
+	addToIndex(this, obj, index);
+
+	release(old);
+}
+
+/**
+ * @see MutableArray::sort(MutableArray *, Comparator)
+ */
+static void sort(MutableArray *self, Comparator comparator) {
+
+	super(MutableArray, self, sort, comparator);
+
+	invalidateIndex((IndexedArray *) self);
+}
+
+/**
+ * @see MutableArray::sortParallel(MutableArray *, Comparator, size_t)
+ */
+static void sortParallel(MutableArray *self, Comparator comparator, size_t concurrency) {
+
+	super(MutableArray, self, sortParallel, comparator, concurrency);
+
+	invalidateIndex((IndexedArray *) self);
+}
+
+/**
+ * @see MutableArray::sortStable(MutableArray *, Comparator)
+ */
+static void sortStable(MutableArray *self, Comparator comparator) {
+
+	super(MutableArray, self, sortStable, comparator);
+
+	invalidateIndex((IndexedArray *) self);
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	ObjectInterface *object = (ObjectInterface *) clazz->def->interface;
+
+	object->copy = copy;
+	object->dealloc = dealloc;
+
+	ArrayInterface *array_ = (ArrayInterface *) clazz->def->interface;
+
+	array_->indexOfObject = indexOfObject;
+
+	MutableArrayInterface *mutableArray = (MutableArrayInterface *) clazz->def->interface;
+
+	mutableArray->addObject = addObject;
+	mutableArray->addObjectsFromArray = addObjectsFromArray;
+	mutableArray->array = (MutableArray *(*)(void)) array;
+	mutableArray->arrayWithCapacity = (MutableArray *(*)(size_t)) arrayWithCapacity;
+	mutableArray->filter = filter;
+	mutableArray->init = (MutableArray *(*)(MutableArray *)) init;
+	mutableArray->initWithCapacity = (MutableArray *(*)(MutableArray *, size_t)) initWithCapacity;
+	mutableArray->insertObjectAtIndex = insertObjectAtIndex;
+	mutableArray->removeAllObjects = removeAllObjects;
+	mutableArray->removeObjectAtIndex = removeObjectAtIndex;
+	mutableArray->removeObjectsAtIndexes = removeObjectsAtIndexes;
+	mutableArray->removeObjectsInRange = removeObjectsInRange;
+	mutableArray->setObjectAtIndex = setObjectAtIndex;
+	mutableArray->sort = sort;
+	mutableArray->sortParallel = sortParallel;
+	mutableArray->sortStable = sortStable;
+
+	IndexedArrayInterface *indexedArray = (IndexedArrayInterface *) clazz->def->interface;
+
+	indexedArray->array = array;
+	indexedArray->arrayWithCapacity = arrayWithCapacity;
+	indexedArray->init = init;
+	indexedArray->initWithCapacity = initWithCapacity;
+}
+
+/**
+ * @fn Class *IndexedArray::_IndexedArray(void)
+ * @memberof IndexedArray
+ */
+Class *_IndexedArray(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "IndexedArray";
+		clazz.superclass = _MutableArray();
+		clazz.instanceSize = sizeof(IndexedArray);
+		clazz.interfaceOffset = offsetof(IndexedArray, interface);
+		clazz.interfaceSize = sizeof(IndexedArrayInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
@@ -0,0 +1,142 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <Objectively/MutableArray.h>
+
+/**
+ * @file
+ * @brief Mutable arrays with constant time membership tests.
+ */
+
+typedef struct IndexedArray IndexedArray;
+typedef struct IndexedArrayInterface IndexedArrayInterface;
+
+/**
+ * @brief A slot in the hash index of an IndexedArray.
+ * @private
+ */
+typedef struct IndexedArrayEntry IndexedArrayEntry;
+
+/**
+ * @brief Mutable arrays with constant time membership tests.
+ * @details IndexedArray maintains an open-addressed hash index, mapping each distinct Object to the
+ * position of its first occurrence. Array::indexOfObject and Array::containsObject consult the
+ * index rather than scanning, while positional access is unchanged. The index is built lazily, on
+ * the first lookup. Appending, inserting and removing single Objects update it in place; bulk
+ * mutations, such as filtering and sorting, discard it, to be rebuilt on the next lookup.
+ * @remarks Because lookups may build the index, an IndexedArray must not be read from multiple
+ * threads without synchronization. As with Dictionary keys, the hash of an Object must not change
+ * while it is contained in an IndexedArray.
+ * @extends MutableArray
+ * @ingroup Collections
+ */
+struct IndexedArray {
+
+	/**
+	 * @brief The superclass.
+	 */
+	MutableArray mutableArray;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	IndexedArrayInterface *interface;
+
+	/**
+	 * @brief The index, or `NULL` if it has not been built.
+	 * @private
+	 */
+	IndexedArrayEntry *entries;
+
+	/**
+	 * @brief The number of distinct Objects in the index.
+	 * @private
+	 */
+	size_t indexCount;
+
+	/**
+	 * @brief The number of slots in the index, which is always zero or a power of two.
+	 * @private
+	 */
+	size_t indexCapacity;
+};
+
+/**
+ * @brief The IndexedArray interface.
+ */
+struct IndexedArrayInterface {
+
+	/**
+	 * @brief The superclass interface.
+	 */
+	MutableArrayInterface mutableArrayInterface;
+
+	/**
+	 * @static
+	 * @fn IndexedArray *IndexedArray::array(void)
+	 * @brief Returns a new IndexedArray.
+	 * @return The new IndexedArray, or `NULL` on error.
+	 * @memberof IndexedArray
+	 */
+	IndexedArray *(*array)(void);
+
+	/**
+	 * @static
+	 * @fn IndexedArray *IndexedArray::arrayWithCapacity(size_t capacity)
+	 * @brief Returns a new IndexedArray with the given `capacity`.
+	 * @param capacity The desired initial capacity.
+	 * @return The new IndexedArray, or `NULL` on error.
+	 * @memberof IndexedArray
+	 */
+	IndexedArray *(*arrayWithCapacity)(size_t capacity);
+
+	/**
+	 * @fn IndexedArray *IndexedArray::init(IndexedArray *self)
+	 * @brief Initializes this IndexedArray.
+	 * @param self The IndexedArray.
+	 * @return The initialized IndexedArray, or `NULL` on error.
+	 * @memberof IndexedArray
+	 */
+	IndexedArray *(*init)(IndexedArray *self);
+
+	/**
+	 * @fn IndexedArray *IndexedArray::initWithCapacity(IndexedArray *self, size_t capacity)
+	 * @brief Initializes this IndexedArray with the specified capacity.
+	 * @param self The IndexedArray.
+	 * @param capacity The desired initial capacity.
+	 * @return The initialized IndexedArray, or `NULL` on error.
+	 * @memberof IndexedArray
+	 */
+	IndexedArray *(*initWithCapacity)(IndexedArray *self, size_t capacity);
+};
+
+/**
+ * @fn Class *IndexedArray::_IndexedArray(void)
+ * @brief The IndexedArray archetype.
+ * @return The IndexedArray Class.
+ * @memberof IndexedArray
+ */
+OBJECTIVELY_EXPORT Class *_IndexedArray(void);
@@ -32,6 +32,7 @@
 #include <Objectively/MutableArray.h>
 #include <Objectively/Null.h>
 #include <Objectively/Number.h>
+#include <Objectively/OrderedDictionary.h>
 #include <Objectively/String.h>
 
 #define _Class _JSONSerialization
@@ -119,21 +120,18 @@ static void writeObject(JSONWriter *writer, const Dictionary *object) {
 
 	$(writer->data, appendBytes, (uint8_t * ) "{", 1);
 
-	Array *keys = $(object, allKeys);
-	for (size_t i = 0; i < keys->count; i++) {
+	DictionaryIterator iterator = $(object, iterator);
+	ident obj, key;
 
-		const ident key = $(keys, objectAtIndex, i);
-		writeLabel(writer, (String *) key);
-
-		const ident obj = $(object, objectForKey, key);
-		writeElement(writer, obj);
+	for (size_t i = 0; $(object, nextObjectAndKey, &iterator, &obj, &key); i++) {
 
-		if (i < keys->count - 1) {
+		if (i > 0) {
 			$(writer->data, appendBytes, (uint8_t *) ", ", 2);
 		}
-	}
 
-	release(keys);
+		writeLabel(writer, (String *) key);
+		writeElement(writer, obj);
+	}
 
 	$(writer->data, appendBytes, (uint8_t * ) "}", 1);
 }
@@ -364,7 +362,7 @@ static String *readLabel(JSONReader *reader) {
  */
 static Dictionary *readObject(JSONReader *reader) {
 
-	MutableDictionary *object = $(alloc(MutableDictionary), init);
+	MutableDictionary *object = (MutableDictionary *) $(alloc(OrderedDictionary), init);
 
 	while (true) {
 
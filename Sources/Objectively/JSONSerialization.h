@@ -91,6 +91,8 @@ struct JSONSerializationInterface {
 	 * @param data The JSON Data.
 	 * @param options A bitwise-or of `JSON_READ_*`.
 	 * @return The Object, or `NULL` on error.
+	 * @remarks JSON objects are parsed into OrderedDictionaries, so that their members are
+	 * enumerated, and written back out, in the order in which they appear in `data`.
 	 * @memberof JSONSerialization
 	 */
 	ident (*objectFromData)(const Data *data, int options);
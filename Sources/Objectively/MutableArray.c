@@ -21,15 +21,63 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
+#include <Objectively/Config.h>
+
 #include <assert.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
 
 #include <Objectively/MutableArray.h>
+#include <Objectively/Thread.h>
 
 #define _Class _MutableArray
 
-#define ARRAY_CHUNK_SIZE 64
+#define MUTABLEARRAY_MIN_CAPACITY 16
+
+/**
+ * @brief The length of the subarrays which are insertion sorted rather than merged.
+ */
+#define MUTABLEARRAY_SORT_RUN 16
+
+/**
+ * @brief The minimum number of elements sorted by each Thread of a parallel sort.
+ */
+#define MUTABLEARRAY_PARALLEL_SORT_MIN 16384
+
+/**
+ * @brief Resizes the backing array of `self` to exactly `capacity` elements.
+ */
+static void resize(MutableArray *self, size_t capacity) {
+
+	assert(capacity >= self->array.count);
+
+	if (capacity) {
+		self->array.elements = realloc(self->array.elements, capacity * sizeof(ident));
+		assert(self->array.elements);
+	} else {
+		free(self->array.elements);
+		self->array.elements = NULL;
+	}
+
+	self->capacity = capacity;
+}
+
+/**
+ * @brief Ensures that `self` can hold `count` elements, growing geometrically.
+ * @remarks Growing by half of the current capacity keeps the cost of appending amortized
+ * constant, while allowing the allocator to reuse previously freed blocks.
+ */
+static inline void grow(MutableArray *self, size_t count) {
+
+	if (count > self->capacity) {
+		resize(self, max(count, max(self->capacity + (self->capacity >> 1), (size_t) MUTABLEARRAY_MIN_CAPACITY)));
+	}
+}
 
 #pragma mark - Object
 
@@ -55,21 +103,9 @@ static Object *copy(const Object *self) {
  */
 static void addObject(MutableArray *self, const ident obj) {
 
-	Array *array = (Array *) self;
-	if (array->count == self->capacity) {
+	grow(self, self->array.count + 1);
 
-		self->capacity += ARRAY_CHUNK_SIZE;
-
-		if (array->elements) {
-			array->elements = realloc(array->elements, self->capacity * sizeof(ident));
-		} else {
-			array->elements = calloc(self->capacity, sizeof(ident));
-		}
-
-		assert(array->elements);
-	}
-
-	array->elements[array->count++] = retain(obj);
+	self->array.elements[self->array.count++] = retain(obj);
 }
 
 /**
@@ -97,8 +133,11 @@ static void addObjects(MutableArray *self, const ident obj, ...) {
 static void addObjectsFromArray(MutableArray *self, const Array *array) {
 
 	if (array) {
+
+		grow(self, self->array.count + array->count);
+
 		for (size_t i = 0; i < array->count; i++) {
-			$(self, addObject, array->elements[i]);
+			self->array.elements[self->array.count++] = retain(array->elements[i]);
 		}
 	}
 }
@@ -129,11 +168,20 @@ static void filter(MutableArray *self, Predicate predicate, ident data) {
 
 	assert(predicate);
 
+	size_t count = 0;
+
 	for (size_t i = 0; i < self->array.count; i++) {
-		if (predicate(self->array.elements[i], data) == false) {
-			$(self, removeObjectAtIndex, i--);
+
+		const ident obj = self->array.elements[i];
+
+		if (predicate(obj, data)) {
+			self->array.elements[count++] = obj;
+		} else {
+			release(obj);
 		}
 	}
+
+	self->array.count = count;
 }
 
 /**
@@ -173,13 +221,13 @@ static void insertObjectAtIndex(MutableArray *self, ident obj, size_t index) {
 
 	assert(index < self->array.count);
 
-	$(self, addObject, obj);
+	grow(self, self->array.count + 1);
 
-	for (size_t i = self->array.count - 1; i > index; i--) {
-		self->array.elements[i] = self->array.elements[i - 1];
-	}
+	ident *elements = self->array.elements + index;
+	memmove(elements + 1, elements, (self->array.count - index) * sizeof(ident));
 
-	self->array.elements[index] = obj;
+	*elements = retain(obj);
+	self->array.count++;
 }
 
 /**
@@ -189,8 +237,10 @@ static void insertObjectAtIndex(MutableArray *self, ident obj, size_t index) {
 static void removeAllObjects(MutableArray *self) {
 
 	for (size_t i = self->array.count; i > 0; i--) {
-		$(self, removeObjectAtIndex, i - 1);
+		release(self->array.elements[i - 1]);
 	}
+
+	self->array.count = 0;
 }
 
 /**
@@ -215,13 +265,72 @@ static void removeObjectAtIndex(MutableArray *self, size_t index) {
 
 	release(self->array.elements[index]);
 
-	for (size_t i = index; i < self->array.count - 1; i++) {
-		self->array.elements[i] = self->array.elements[i + 1];
-	}
+	ident *elements = self->array.elements + index;
+	memmove(elements, elements + 1, (self->array.count - index - 1) * sizeof(ident));
 
 	self->array.count--;
 }
 
+/**
+ * @fn void MutableArray::removeObjectsAtIndexes(MutableArray *self, const IndexSet *indexes)
+ * @memberof MutableArray
+ */
+static void removeObjectsAtIndexes(MutableArray *self, const IndexSet *indexes) {
+
+	assert(indexes);
+
+	if (indexes->count == 0) {
+		return;
+	}
+
+	assert(indexes->indexes[indexes->count - 1] < self->array.count);
+
+	size_t count = indexes->indexes[0];
+
+	for (size_t i = count, j = 0; i < self->array.count; i++) {
+
+		if (j < indexes->count && indexes->indexes[j] == i) {
+			release(self->array.elements[i]);
+			j++;
+		} else {
+			self->array.elements[count++] = self->array.elements[i];
+		}
+	}
+
+	self->array.count = count;
+}
+
+/**
+ * @fn void MutableArray::removeObjectsInRange(MutableArray *self, const Range range)
+ * @memberof MutableArray
+ */
+static void removeObjectsInRange(MutableArray *self, const Range range) {
+
+	assert(range.location >= 0);
+	assert(range.location + range.length <= self->array.count);
+
+	ident *elements = self->array.elements + range.location;
+
+	for (size_t i = 0; i < range.length; i++) {
+		release(elements[i]);
+	}
+
+	memmove(elements, elements + range.length, (self->array.count - range.location - range.length) * sizeof(ident));
+
+	self->array.count -= range.length;
+}
+
+/**
+ * @fn void MutableArray::reserveCapacity(MutableArray *self, size_t capacity)
+ * @memberof MutableArray
+ */
+static void reserveCapacity(MutableArray *self, size_t capacity) {
+
+	if (capacity > self->capacity && capacity > self->array.count) {
+		resize(self, capacity);
+	}
+}
+
 /**
  * @fn void MutableArray::setObjectAtIndex(MutableArray *self, const ident obj, size_t index)
  * @memberof MutableArray
@@ -237,6 +346,282 @@ static void setObjectAtIndex(MutableArray *self, const ident obj, size_t index)
 	self->array.elements[index] = obj;
 }
 
+/**
+ * @fn void MutableArray::shrinkToFit(MutableArray *self)
+ * @memberof MutableArray
+ */
+static void shrinkToFit(MutableArray *self) {
+
+	if (self->capacity > self->array.count) {
+		resize(self, self->array.count);
+	}
+}
+
+/**
+ * @brief Stably merges `src[begin, middle)` and `src[middle, end)` into `dest[begin, end)`.
+ */
+static void merge(const ident *src, ident *dest, size_t begin, size_t middle, size_t end, Comparator comparator) {
+
+	size_t i = begin, j = middle, k = begin;
+
+	if (i < middle && j < end && comparator(src[middle - 1], src[middle]) != OrderDescending) {
+		memcpy(dest + begin, src + begin, (end - begin) * sizeof(ident));
+		return;
+	}
+
+	while (i < middle && j < end) {
+		if (comparator(src[j], src[i]) == OrderAscending) {
+			dest[k++] = src[j++];
+		} else {
+			dest[k++] = src[i++];
+		}
+	}
+
+	memcpy(dest + k, src + i, (middle - i) * sizeof(ident));
+	k += middle - i;
+
+	memcpy(dest + k, src + j, (end - j) * sizeof(ident));
+}
+
+/**
+ * @brief Insertion sorts `elements[begin, end)`.
+ */
+static void insertionSort(ident *elements, size_t begin, size_t end, Comparator comparator) {
+
+	for (size_t i = begin + 1; i < end; i++) {
+
+		const ident obj = elements[i];
+
+		size_t j = i;
+		while (j > begin && comparator(obj, elements[j - 1]) == OrderAscending) {
+			elements[j] = elements[j - 1];
+			j--;
+		}
+
+		elements[j] = obj;
+	}
+}
+
+/**
+ * @brief Sorts `src[begin, end)` into `dest[begin, end)`, where both initially hold the same elements.
+ * @details The halves are sorted into `src`, alternating roles at each level of recursion, so that
+ * they may be merged into `dest` without copying back.
+ */
+static void splitMerge(ident *src, ident *dest, size_t begin, size_t end, Comparator comparator) {
+
+	if (end - begin <= MUTABLEARRAY_SORT_RUN) {
+		insertionSort(dest, begin, end, comparator);
+		return;
+	}
+
+	const size_t middle = begin + ((end - begin) >> 1);
+
+	splitMerge(dest, src, begin, middle, comparator);
+	splitMerge(dest, src, middle, end, comparator);
+
+	merge(src, dest, begin, middle, end, comparator);
+}
+
+/**
+ * @brief Stably sorts the `count` elements, using `scratch` as temporary storage.
+ * @details The sort is a top down merge sort, which completes small subarrays while they are
+ * still in cache.
+ */
+static void mergeSort(ident *elements, ident *scratch, size_t count, Comparator comparator) {
+
+	if (count <= MUTABLEARRAY_SORT_RUN) {
+		insertionSort(elements, 0, count, comparator);
+	} else {
+		memcpy(scratch, elements, count * sizeof(ident));
+		splitMerge(scratch, elements, 0, count, comparator);
+	}
+}
+
+typedef struct SortJob SortJob;
+
+/**
+ * @brief A unit of work for a parallel sort: sorting a chunk, or merging two adjacent chunks.
+ */
+struct SortJob {
+	void (*function)(const SortJob *job);
+	Comparator comparator;
+	ident *elements;
+	ident *scratch;
+	size_t begin, middle, end;
+};
+
+/**
+ * @brief Sorts the chunk `[begin, end)`.
+ */
+static void sortChunk(const SortJob *job) {
+
+	mergeSort(job->elements + job->begin, job->scratch + job->begin, job->end - job->begin, job->comparator);
+}
+
+/**
+ * @brief Merges the sorted chunks `[begin, middle)` and `[middle, end)`.
+ */
+static void mergeChunks(const SortJob *job) {
+
+	merge(job->elements, job->scratch, job->begin, job->middle, job->end, job->comparator);
+
+	memcpy(job->elements + job->begin, job->scratch + job->begin, (job->end - job->begin) * sizeof(ident));
+}
+
+/**
+ * @brief ThreadFunction for running a SortJob.
+ */
+static ident runSortJob(Thread *thread) {
+
+	const SortJob *job = thread->data;
+
+	job->function(job);
+
+	return NULL;
+}
+
+/**
+ * @brief Runs `count` SortJobs concurrently, running the last on the calling thread.
+ */
+static void runSortJobs(const SortJob *jobs, size_t count) {
+
+	Thread **threads = calloc(count, sizeof(Thread *));
+	assert(threads);
+
+	for (size_t i = 0; i < count - 1; i++) {
+		threads[i] = $(alloc(Thread), initWithFunction, runSortJob, (ident) &jobs[i]);
+		$(threads[i], start);
+	}
+
+	jobs[count - 1].function(&jobs[count - 1]);
+
+	for (size_t i = 0; i < count - 1; i++) {
+		$(threads[i], join, NULL);
+		release(threads[i]);
+	}
+
+	free(threads);
+}
+
+/**
+ * @return The number of online processors.
+ */
+static size_t processors(void) {
+
+#if defined(_SC_NPROCESSORS_ONLN)
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	if (count > 0) {
+		return (size_t) count;
+	}
+#endif
+
+	return 1;
+}
+
+/**
+ * @fn void MutableArray::sortParallel(MutableArray *self, Comparator comparator, size_t concurrency)
+ * @memberof MutableArray
+ */
+static void sortParallel(MutableArray *self, Comparator comparator, size_t concurrency) {
+
+	assert(comparator);
+
+	const size_t count = self->array.count;
+
+	if (concurrency == 0) {
+		concurrency = processors();
+	}
+
+	concurrency = min(concurrency, count / MUTABLEARRAY_PARALLEL_SORT_MIN);
+
+	if (concurrency < 2) {
+		$(self, sortStable, comparator);
+		return;
+	}
+
+	ident *scratch = malloc(count * sizeof(ident));
+	assert(scratch);
+
+	size_t *bounds = calloc(concurrency + 1, sizeof(size_t));
+	assert(bounds);
+
+	for (size_t i = 0; i <= concurrency; i++) {
+		bounds[i] = count * i / concurrency;
+	}
+
+	SortJob *jobs = calloc(concurrency, sizeof(SortJob));
+	assert(jobs);
+
+	for (size_t i = 0; i < concurrency; i++) {
+		jobs[i] = (SortJob) {
+			.function = sortChunk,
+			.comparator = comparator,
+			.elements = self->array.elements,
+			.scratch = scratch,
+			.begin = bounds[i],
+			.end = bounds[i + 1]
+		};
+	}
+
+	runSortJobs(jobs, concurrency);
+
+	// merge adjacent pairs of chunks until one remains, carrying any odd chunk to the next round
+
+	for (size_t chunks = concurrency; chunks > 1; chunks = (chunks + 1) >> 1) {
+
+		const size_t merges = chunks >> 1;
+
+		for (size_t i = 0; i < merges; i++) {
+			jobs[i] = (SortJob) {
+				.function = mergeChunks,
+				.comparator = comparator,
+				.elements = self->array.elements,
+				.scratch = scratch,
+				.begin = bounds[i * 2],
+				.middle = bounds[i * 2 + 1],
+				.end = bounds[i * 2 + 2]
+			};
+		}
+
+		runSortJobs(jobs, merges);
+
+		for (size_t i = 0; i <= chunks; i += 2) {
+			bounds[i >> 1] = bounds[i];
+		}
+
+		if (chunks & 1) {
+			bounds[(chunks + 1) >> 1] = bounds[chunks];
+		}
+	}
+
+	free(jobs);
+	free(bounds);
+	free(scratch);
+}
+
+/**
+ * @fn void MutableArray::sortStable(MutableArray *self, Comparator comparator)
+ * @memberof MutableArray
+ */
+static void sortStable(MutableArray *self, Comparator comparator) {
+
+	assert(comparator);
+
+	const size_t count = self->array.count;
+
+	if (count > MUTABLEARRAY_SORT_RUN) {
+
+		ident *scratch = malloc(count * sizeof(ident));
+		assert(scratch);
+
+		mergeSort(self->array.elements, scratch, count, comparator);
+
+		free(scratch);
+	} else {
+		insertionSort(self->array.elements, 0, count, comparator);
+	}
+}
+
 #if defined(__APPLE__)
 
 /**
@@ -316,8 +701,14 @@ static void initialize(Class *clazz) {
 	mutableArray->removeAllObjects = removeAllObjects;
 	mutableArray->removeObject = removeObject;
 	mutableArray->removeObjectAtIndex = removeObjectAtIndex;
+	mutableArray->removeObjectsAtIndexes = removeObjectsAtIndexes;
+	mutableArray->removeObjectsInRange = removeObjectsInRange;
+	mutableArray->reserveCapacity = reserveCapacity;
 	mutableArray->setObjectAtIndex = setObjectAtIndex;
+	mutableArray->shrinkToFit = shrinkToFit;
 	mutableArray->sort = sort;
+	mutableArray->sortParallel = sortParallel;
+	mutableArray->sortStable = sortStable;
 }
 
 /**
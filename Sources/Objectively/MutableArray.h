@@ -24,6 +24,7 @@
 #pragma once
 
 #include <Objectively/Array.h>
+#include <Objectively/IndexSet.h>
 
 /**
  * @file
@@ -119,6 +120,7 @@ struct MutableArrayInterface {
 	 * @param self The MutableArray.
 	 * @param predicate A Predicate.
 	 * @param data User data.
+	 * @remarks The retained Objects are compacted in a single pass, preserving their order.
 	 * @memberof MutableArray
 	 */
 	void (*filter)(MutableArray *self, Predicate predicate, ident data);
@@ -178,6 +180,34 @@ struct MutableArrayInterface {
 	 */
 	void (*removeObjectAtIndex)(MutableArray *self, size_t index);
 
+	/**
+	 * @fn void MutableArray::removeObjectsAtIndexes(MutableArray *self, const IndexSet *indexes)
+	 * @brief Removes the Objects at the specified indexes.
+	 * @param self The MutableArray.
+	 * @param indexes The indexes of the Objects to remove.
+	 * @remarks The remaining Objects are compacted in a single pass, preserving their order.
+	 * @memberof MutableArray
+	 */
+	void (*removeObjectsAtIndexes)(MutableArray *self, const IndexSet *indexes);
+
+	/**
+	 * @fn void MutableArray::removeObjectsInRange(MutableArray *self, const Range range)
+	 * @brief Removes the Objects in the specified Range.
+	 * @param self The MutableArray.
+	 * @param range The Range of the Objects to remove.
+	 * @memberof MutableArray
+	 */
+	void (*removeObjectsInRange)(MutableArray *self, const Range range);
+
+	/**
+	 * @fn void MutableArray::reserveCapacity(MutableArray *self, size_t capacity)
+	 * @brief Ensures that this MutableArray can hold `capacity` Objects without reallocating.
+	 * @param self The MutableArray.
+	 * @param capacity The desired capacity.
+	 * @memberof MutableArray
+	 */
+	void (*reserveCapacity)(MutableArray *self, size_t capacity);
+
 	/**
 	 * @fn void MutableArray::setObjectAtIndex(MutableArray *self, const ident obj, size_t index)
 	 * @brief Replaces the Object at the specified index.
@@ -189,14 +219,45 @@ struct MutableArrayInterface {
 	 */
 	void (*setObjectAtIndex)(MutableArray *self, const ident obj, size_t index);
 
+	/**
+	 * @fn void MutableArray::shrinkToFit(MutableArray *self)
+	 * @brief Releases any capacity of this MutableArray in excess of its count.
+	 * @param self The MutableArray.
+	 * @memberof MutableArray
+	 */
+	void (*shrinkToFit)(MutableArray *self);
+
 	/**
 	 * @fn void MutableArray::sort(MutableArray *self, Comparator comparator)
 	 * @brief Sorts this MutableArray in place using `comparator`.
 	 * @param self The MutableArray.
 	 * @param comparator A Comparator.
+	 * @remarks This sort is not stable. See MutableArray::sortStable.
 	 * @memberof MutableArray
 	 */
 	void (*sort)(MutableArray *self, Comparator comparator);
+
+	/**
+	 * @fn void MutableArray::sortParallel(MutableArray *self, Comparator comparator, size_t concurrency)
+	 * @brief Stably sorts this MutableArray in place using `comparator`, across multiple Threads.
+	 * @param self The MutableArray.
+	 * @param comparator A Comparator, which must be safe to call from any Thread.
+	 * @param concurrency The maximum number of Threads to use, or `0` for the number of processors.
+	 * @remarks Chunks of this MutableArray are sorted concurrently, and then merged pairwise. The
+	 * result is identical to that of MutableArray::sortStable.
+	 * @memberof MutableArray
+	 */
+	void (*sortParallel)(MutableArray *self, Comparator comparator, size_t concurrency);
+
+	/**
+	 * @fn void MutableArray::sortStable(MutableArray *self, Comparator comparator)
+	 * @brief Stably sorts this MutableArray in place using `comparator`.
+	 * @param self The MutableArray.
+	 * @param comparator A Comparator.
+	 * @remarks Objects which compare as OrderSame retain their relative order.
+	 * @memberof MutableArray
+	 */
+	void (*sortStable)(MutableArray *self, Comparator comparator);
 };
 
 /**
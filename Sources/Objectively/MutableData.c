@@ -44,6 +44,17 @@ static Object *copy(const Object *self) {
 	return (Object *) that;
 }
 
+/**
+ * @see Object::hash(const Object *)
+ * @remarks MutableData may be modified through its bytes, so its hash is not cached.
+ */
+static int hash(const Object *self) {
+
+	((Data *) self)->hash = 0;
+
+	return super(Object, self, hash);
+}
+
 #pragma mark - MutableData
 
 /**
@@ -164,6 +175,7 @@ static void initialize(Class *clazz) {
 	ObjectInterface *object = (ObjectInterface *) clazz->def->interface;
 
 	object->copy = copy;
+	object->hash = hash;
 
 	MutableDataInterface *mutableData = (MutableDataInterface *) clazz->def->interface;
 
@@ -24,9 +24,9 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <Objectively/Hash.h>
-#include <Objectively/MutableArray.h>
 #include <Objectively/MutableDictionary.h>
 
 #define _Class _MutableDictionary
@@ -34,6 +34,7 @@
 #define MUTABLEDICTIONARY_DEFAULT_CAPACITY 64
 #define MUTABLEDICTIONARY_GROW_FACTOR 2.0
 #define MUTABLEDICTIONARY_MAX_LOAD 0.75
+#define MUTABLEDICTIONARY_MIGRATE_SLOTS 4
 
 #pragma mark - Object
 
@@ -106,11 +107,15 @@ static MutableDictionary *initWithCapacity(MutableDictionary *self, size_t capac
 	self = (MutableDictionary *) super(Object, self, init);
 	if (self) {
 
-		self->dictionary.capacity = capacity;
-		if (self->dictionary.capacity) {
+		if (capacity) {
 
-			self->dictionary.elements = calloc(self->dictionary.capacity, sizeof(ident));
-			assert(self->dictionary.elements);
+			self->dictionary.capacity = 1;
+			while (self->dictionary.capacity < capacity) {
+				self->dictionary.capacity <<= 1;
+			}
+
+			self->dictionary.entries = calloc(self->dictionary.capacity, sizeof(DictionaryEntry));
+			assert(self->dictionary.entries);
 		}
 	}
 
@@ -118,92 +123,116 @@ static MutableDictionary *initWithCapacity(MutableDictionary *self, size_t capac
 }
 
 /**
- * @fn void MutableDictionary::removeAllObjects(MutableDictionary *self)
- * @memberof MutableDictionary
+ * @brief Migrates up to `slots` slots of the previous table, if any, into the current table.
+ * @remarks Entries are placed by their cached hash, and are not retained again. Migrated slots
+ * have their object cleared, so that probes of the previous table no longer compare their keys.
  */
-static void removeAllObjects(MutableDictionary *self) {
+static void migrate(Dictionary *dict, size_t slots) {
+
+	if (dict->previousEntries == NULL) {
+		return;
+	}
+
+	const size_t mask = dict->capacity - 1;
+	const size_t end = min(dict->previousCapacity, dict->migrated + slots);
 
-	for (size_t i = 0; i < self->dictionary.capacity; i++) {
+	for (; dict->migrated < end; dict->migrated++) {
 
-		Array *array = self->dictionary.elements[i];
-		if (array) {
-			release(array);
-			self->dictionary.elements[i] = NULL;
+		DictionaryEntry *entry = &dict->previousEntries[dict->migrated];
+		if (entry->key) {
+
+			if (entry->object) {
+				_dictionaryPlaceEntry(dict->entries, dict->capacity, *entry, entry->hash & mask, 0);
+				entry->object = NULL;
+			} else {
+				release(entry->key);
+			}
 		}
 	}
 
-	self->dictionary.count = 0;
+	if (dict->migrated == dict->previousCapacity) {
+
+		free(dict->previousEntries);
+
+		dict->previousEntries = NULL;
+		dict->previousCapacity = 0;
+		dict->migrated = 0;
+	}
 }
 
 /**
- * @fn void MutableDictionary::removeObjectForKey(MutableDictionary *self, const ident key)
+ * @fn void MutableDictionary::removeAllObjects(MutableDictionary *self)
  * @memberof MutableDictionary
  */
-static void removeObjectForKey(MutableDictionary *self, const ident key) {
-
-	const size_t bin = HashForObject(HASH_SEED, key) % self->dictionary.capacity;
-
-	MutableArray *array = self->dictionary.elements[bin];
-	if (array) {
+static void removeAllObjects(MutableDictionary *self) {
 
-		const ssize_t index = $((Array *) array, indexOfObject, key);
-		if (index > -1) {
+	Dictionary *dict = (Dictionary *) self;
 
-			$(array, removeObjectAtIndex, index);
-			$(array, removeObjectAtIndex, index);
+	for (size_t i = 0; i < dict->capacity; i++) {
 
-			if (((Array *) array)->count == 0) {
-				release(array);
-				self->dictionary.elements[bin] = NULL;
-			}
+		DictionaryEntry *entry = &dict->entries[i];
+		if (entry->key) {
+			release(entry->key);
+			release(entry->object);
 
-			self->dictionary.count--;
+			memset(entry, 0, sizeof(*entry));
 		}
 	}
-}
 
-/**
- * @brief A helper for resizing Dictionaries as pairs are added to them.
- * @remarks Static method invocations are used for all operations.
- */
-static void setObjectForKey_resize(Dictionary *dict) {
+	for (size_t i = dict->migrated; i < dict->previousCapacity; i++) {
 
-	if (dict->capacity) {
+		const DictionaryEntry *entry = &dict->previousEntries[i];
+		if (entry->key) {
+			release(entry->key);
+			release(entry->object);
+		}
+	}
 
-		const float load = dict->count / (float) dict->capacity;
-		if (load >= MUTABLEDICTIONARY_MAX_LOAD) {
+	free(dict->previousEntries);
 
-			size_t capacity = dict->capacity;
-			ident *elements = dict->elements;
+	dict->previousEntries = NULL;
+	dict->previousCapacity = 0;
+	dict->migrated = 0;
 
-			dict->capacity = dict->capacity * MUTABLEDICTIONARY_GROW_FACTOR;
-			dict->count = 0;
+	dict->count = 0;
+}
 
-			dict->elements = calloc(dict->capacity, sizeof(ident));
-			assert(dict->elements);
+/**
+ * @fn void MutableDictionary::removeObjectForKey(MutableDictionary *self, const ident key)
+ * @memberof MutableDictionary
+ */
+static void removeObjectForKey(MutableDictionary *self, const ident key) {
 
-			for (size_t i = 0; i < capacity; i++) {
+	if (((Dictionary *) self)->count) {
+		_mutableDictionaryRemoveObjectForKey(self, HashFinalize(HashForObject(HASH_SEED, key)), key);
+	}
+}
 
-				Array *array = elements[i];
-				if (array) {
+/**
+ * @brief A helper for resizing Dictionaries as pairs are added to them.
+ * @remarks The current table becomes the previous table, and is migrated incrementally.
+ */
+static void setObjectForKey_resize(Dictionary *dict) {
 
-					for (size_t j = 0; j < array->count; j += 2) {
+	if (dict->count < dict->capacity * MUTABLEDICTIONARY_MAX_LOAD) {
+		return;
+	}
 
-						ident key = $(array, objectAtIndex, j);
-						ident obj = $(array, objectAtIndex, j + 1);
+	migrate(dict, dict->previousCapacity);
 
-						$$(MutableDictionary, setObjectForKey, (MutableDictionary *) dict, obj, key);
-					}
+	if (dict->capacity) {
 
-					release(array);
-				}
-			}
+		dict->previousEntries = dict->entries;
+		dict->previousCapacity = dict->capacity;
+		dict->migrated = 0;
 
-			free(elements);
-		}
+		dict->capacity = dict->capacity * MUTABLEDICTIONARY_GROW_FACTOR;
 	} else {
-		$$(MutableDictionary, initWithCapacity, (MutableDictionary *) dict, MUTABLEDICTIONARY_DEFAULT_CAPACITY);
+		dict->capacity = MUTABLEDICTIONARY_DEFAULT_CAPACITY;
 	}
+
+	dict->entries = calloc(dict->capacity, sizeof(DictionaryEntry));
+	assert(dict->entries);
 }
 
 /**
@@ -212,26 +241,9 @@ static void setObjectForKey_resize(Dictionary *dict) {
  */
 static void setObjectForKey(MutableDictionary *self, const ident obj, const ident key) {
 
-	Dictionary *dict = (Dictionary *) self;
-
-	setObjectForKey_resize(dict);
-
-	const size_t bin = HashForObject(HASH_SEED, key) % dict->capacity;
-
-	MutableArray *array = dict->elements[bin];
-	if (array == NULL) {
-		array = dict->elements[bin] = $(alloc(MutableArray), init);
-	}
+	assert(key);
 
-	const ssize_t index = $((Array *) array, indexOfObject, key);
-	if (index > -1) {
-		$(array, setObjectAtIndex, obj, index + 1);
-	} else {
-		$(array, addObject, key);
-		$(array, addObject, obj);
-
-		dict->count++;
-	}
+	_mutableDictionarySetObjectForKey(self, obj, HashFinalize(HashForObject(HASH_SEED, key)), key);
 }
 
 /**
@@ -302,4 +314,113 @@ Class *_MutableDictionary(void) {
 	return &clazz;
 }
 
+void _mutableDictionaryRemoveObjectForKey(MutableDictionary *self, unsigned hash, const ident key) {
+
+	Dictionary *dict = (Dictionary *) self;
+
+	if (dict->count == 0) {
+		return;
+	}
+
+	migrate(dict, MUTABLEDICTIONARY_MIGRATE_SLOTS);
+
+	ssize_t index = _dictionaryEntryIndex(dict->entries, dict->capacity, hash, key);
+	if (index > -1) {
+
+		const size_t mask = dict->capacity - 1;
+		size_t i = index;
+
+		release(dict->entries[i].key);
+		release(dict->entries[i].object);
+
+		// shift the following entries back towards their home slots, so that no tombstone is needed
+
+		for (size_t j = (i + 1) & mask; ; i = j, j = (j + 1) & mask) {
+
+			const DictionaryEntry *next = &dict->entries[j];
+			if (next->key == NULL || ((j - next->hash) & mask) == 0) {
+				break;
+			}
+
+			dict->entries[i] = *next;
+		}
+
+		memset(&dict->entries[i], 0, sizeof(DictionaryEntry));
+
+		dict->count--;
+		return;
+	}
+
+	if (dict->previousEntries) {
+
+		index = _dictionaryEntryIndex(dict->previousEntries, dict->previousCapacity, hash, key);
+		if (index > -1) {
+
+			DictionaryEntry *entry = &dict->previousEntries[index];
+
+			release(entry->object);
+			entry->object = NULL;
+
+			dict->count--;
+		}
+	}
+}
+
+void _mutableDictionarySetObjectForKey(MutableDictionary *self, const ident obj, unsigned hash, const ident key) {
+
+	assert(obj);
+	assert(key);
+
+	Dictionary *dict = (Dictionary *) self;
+
+	setObjectForKey_resize(dict);
+
+	migrate(dict, MUTABLEDICTIONARY_MIGRATE_SLOTS);
+
+	if (dict->previousEntries) {
+
+		const ssize_t index = _dictionaryEntryIndex(dict->previousEntries, dict->previousCapacity, hash, key);
+		if (index > -1) {
+
+			DictionaryEntry *entry = &dict->previousEntries[index];
+
+			retain(obj);
+			release(entry->object);
+
+			entry->object = obj;
+			return;
+		}
+	}
+
+	const size_t mask = dict->capacity - 1;
+
+	for (size_t i = hash & mask, distance = 0; ; i = (i + 1) & mask, distance++) {
+
+		DictionaryEntry *entry = &dict->entries[i];
+
+		if (entry->key == NULL || ((i - entry->hash) & mask) < distance) {
+
+			const DictionaryEntry inserted = {
+				.key = retain(key),
+				.object = retain(obj),
+				.hash = hash
+			};
+
+			_dictionaryPlaceEntry(dict->entries, dict->capacity, inserted, i, distance);
+
+			dict->count++;
+			return;
+		}
+
+		if (entry->hash == hash && (entry->key == key || $((Object *) entry->key, isEqual, key))) {
+
+			retain(obj);
+			release(entry->object);
+
+			entry->object = obj;
+			return;
+		}
+	}
+}
+
 #undef _Class
@@ -151,3 +151,24 @@ struct MutableDictionaryInterface {
  * @memberof MutableDictionary
  */
 OBJECTIVELY_EXPORT Class *_MutableDictionary(void);
+
+/**
+ * @brief Removes the pair for `key` from the given MutableDictionary, given the key's hash.
+ * @param self The MutableDictionary, whose table must be the one defined by Dictionary.
+ * @param hash The finalized hash of `key`.
+ * @param key The key.
+ * @remarks This allows callers which have already hashed `key` to avoid hashing it again.
+ * @private
+ */
+OBJECTIVELY_EXPORT void _mutableDictionaryRemoveObjectForKey(MutableDictionary *self, unsigned hash, const ident key);
+
+/**
+ * @brief Sets the pair for `key` in the given MutableDictionary, given the key's hash.
+ * @param self The MutableDictionary, whose table must be the one defined by Dictionary.
+ * @param obj The Object.
+ * @param hash The finalized hash of `key`.
+ * @param key The key.
+ * @remarks This allows callers which have already hashed `key` to avoid hashing it again.
+ * @private
+ */
+OBJECTIVELY_EXPORT void _mutableDictionarySetObjectForKey(MutableDictionary *self, const ident obj, unsigned hash, const ident key);
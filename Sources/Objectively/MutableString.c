@@ -76,6 +76,7 @@ static void appendCharacters(MutableString *self, const char *chars) {
 
 			self->string.chars[newSize - 1] = '\0';
 			self->string.length += len;
+			self->string.hash = 0;
 		}
 	}
 }
@@ -135,6 +136,7 @@ static void deleteCharactersInRange(MutableString *self, const Range range) {
 	memmove(ptr, ptr + range.length, length);
 
 	self->string.length -= range.length;
+	self->string.hash = 0;
 }
 
 /**
@@ -212,6 +214,7 @@ static void replaceCharactersInRange(MutableString *self, const Range range, con
 
 	self->string.length = range.location;
 	self->string.chars[range.location + 1] = '\0';
+	self->string.hash = 0;
 
 	$(self, appendCharacters, chars);
 	$(self, appendCharacters, remainder);
@@ -50,7 +50,7 @@ static Null *null(void) {
 	static Once once;
 
 	do_once(&once, {
-		_null = (Null *) $((Object *) alloc(Null), init);
+		_null = immortalize($((Object *) alloc(Null), init));
 	});
 
 	return _null;
@@ -73,7 +73,9 @@ static void initialize(Class *clazz) {
  */
 static void destroy(Class *clazz) {
 
-	release(_null);
+	if (_null) {
+		$((Object *) _null, dealloc);
+	}
 }
 
 /**
@@ -22,6 +22,7 @@
  */
 
 #include <assert.h>
+#include <math.h>
 
 #include <Objectively/Hash.h>
 #include <Objectively/Number.h>
@@ -29,6 +30,18 @@
 
 #define _Class _Number
 
+/**
+ * @brief The least integral value served from the cache.
+ */
+#define NUMBER_CACHE_MIN -128
+
+/**
+ * @brief The greatest integral value served from the cache.
+ */
+#define NUMBER_CACHE_MAX 1023
+
+static Number *_cache[NUMBER_CACHE_MAX - NUMBER_CACHE_MIN + 1];
+
 #pragma mark - Object
 
 /**
@@ -157,6 +170,25 @@ static int intValue(const Number *self) {
  * @memberof Number
  */
 static Number *numberWithValue(double value) {
+
+	if (value >= NUMBER_CACHE_MIN && value <= NUMBER_CACHE_MAX) {
+
+		const int i = (int) value;
+		if (i == value && !(i == 0 && signbit(value))) {
+
+			Number **number = &_cache[i - NUMBER_CACHE_MIN];
+			if (*number == NULL) {
+
+				Number *n = immortalize($(alloc(Number), initWithValue, value));
+				if (!__sync_bool_compare_and_swap(number, NULL, n)) {
+					$((Object *) n, dealloc);
+				}
+			}
+
+			return *number;
+		}
+	}
+
 	return $(alloc(Number), initWithValue, value);
 }
 
@@ -195,6 +227,18 @@ static void initialize(Class *clazz) {
 	number->shortValue = shortValue;
 }
 
+/**
+ * @see Class::destroy(Class *)
+ */
+static void destroy(Class *clazz) {
+
+	for (size_t i = 0; i < lengthof(_cache); i++) {
+		if (_cache[i]) {
+			$((Object *) _cache[i], dealloc);
+		}
+	}
+}
+
 /**
  * @fn Class *Number::_Number(void)
  * @memberof Number
@@ -210,6 +254,7 @@ Class *_Number(void) {
 		clazz.interfaceOffset = offsetof(Number, interface);
 		clazz.interfaceSize = sizeof(NumberInterface);
 		clazz.initialize = initialize;
+		clazz.destroy = destroy;
 	});
 
 	return &clazz;
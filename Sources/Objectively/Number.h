@@ -138,9 +138,11 @@ struct NumberInterface {
 	/**
 	 * @static
 	 * @fn Number *Number::numberWithValue(double value)
-	 * @brief Returns a new Number with the given value.
+	 * @brief Returns a Number with the given value.
 	 * @param value The value.
-	 * @return The new Number, or `NULL` on error.
+	 * @return The Number, or `NULL` on error.
+	 * @remarks Small integral values are served from a cache of immortal Numbers, and do not
+	 * allocate. Release the returned Number as you would any other.
 	 * @memberof Number
 	 */
 	Number *(*numberWithValue)(double value);
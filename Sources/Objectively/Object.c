@@ -38,11 +38,10 @@
  */
 static Object *copy(const Object *self) {
 
-	ident obj = calloc(1, self->clazz->instanceSize);
-	assert(obj);
+	Object *object = _alloc(self->clazz);
 
-	Object *object = memcpy(obj, self, self->clazz->instanceSize);
-	object->referenceCount = 1;
+	const size_t size = self->clazz->instanceSize - sizeof(Object);
+	memcpy((ident) object + sizeof(Object), (ident) self + sizeof(Object), size);
 
 	return object;
 }
@@ -53,7 +52,7 @@ static Object *copy(const Object *self) {
  */
 static void dealloc(Object *self) {
 
-	free(self);
+	_dealloc(self);
 }
 
 /**
@@ -100,15 +99,7 @@ static _Bool isEqual(const Object *self, const Object *other) {
  */
 static _Bool isKindOfClass(const Object *self, const Class *clazz) {
 
-	const Class *c = self->clazz;
-	while (c) {
-		if (c == clazz) {
-			return true;
-		}
-		c = c->superclass;
-	}
-
-	return false;
+	return isSubclassOfClass(self->clazz, clazz);
 }
 
 #pragma mark - Class lifecycle
@@ -57,10 +57,26 @@ struct Object {
 	ObjectInterface *interface;
 
 	/**
-	 * @brief The reference count of this Object.
+	 * @brief The reference count of this Object, as held by its owning thread.
+	 * @details Objects are biased towards the thread that allocated them. The owning thread
+	 * retains and releases without atomic operations; all other threads use
+	 * `sharedReferenceCount`.
 	 * @private
 	 */
 	unsigned referenceCount;
+
+	/**
+	 * @brief The reference count of this Object, as held by all other threads.
+	 * @details This count may be negative, and its low bits are reserved for flags.
+	 * @private
+	 */
+	volatile int sharedReferenceCount;
+
+	/**
+	 * @brief The owning thread, or `NULL` once the reference counts have been merged.
+	 * @private
+	 */
+	ident owner;
 };
 
 typedef struct String String;
@@ -0,0 +1,97 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <Objectively/Config.h>
+
+#include <limits.h>
+#include <sched.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <Objectively/Once.h>
+
+/**
+ * @brief The number of times a waiting thread polls before it sleeps.
+ */
+#define ONCE_SPIN_COUNT 128
+
+/**
+ * @brief The word holds this value while it is being completed, and threads are waiting on it.
+ */
+#define ONCE_WAITING -2
+
+/**
+ * @brief Briefly pauses the calling thread while spinning.
+ */
+static inline void relax(void) {
+#if defined(__i386__) || defined(__x86_64__)
+	__builtin_ia32_pause();
+#endif
+}
+
+void _waitOnce(volatile int *word, int value) {
+
+	for (int i = 0; i < ONCE_SPIN_COUNT; i++) {
+		if (_loadOnce(word) == value) {
+			return;
+		}
+		relax();
+	}
+
+	while (true) {
+
+		const int current = _loadOnce(word);
+		if (current == value) {
+			break;
+		}
+
+		if (current == -1) {
+			__sync_val_compare_and_swap(word, -1, ONCE_WAITING);
+			continue;
+		}
+
+#if defined(__linux__)
+		syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, ONCE_WAITING, NULL, NULL, 0);
+#else
+		sched_yield();
+#endif
+	}
+}
+
+void _wakeOnce(volatile int *word, int value) {
+
+	int current;
+	do {
+		current = *word;
+	} while (__sync_val_compare_and_swap(word, current, value) != current);
+
+#if defined(__linux__)
+	if (current == ONCE_WAITING) {
+		syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+	}
+#endif
+}
@@ -34,15 +34,43 @@
  * @brief The Once type.
  * @ingroup Concurrency
  */
-typedef long Once;
+typedef volatile int Once;
+
+/**
+ * @brief Reads the given word with acquire semantics.
+ * @details Stores made before the word was completed are visible to the caller hereafter.
+ */
+#if defined(__ATOMIC_ACQUIRE)
+ #define _loadOnce(word) __atomic_load_n(word, __ATOMIC_ACQUIRE)
+#else
+ #define _loadOnce(word) (*(word))
+#endif
+
+/**
+ * @brief Blocks the calling thread until `*word` becomes `value`.
+ * @details The calling thread spins briefly, and then sleeps until it is woken by `_wakeOnce`.
+ * While the word is being completed by another thread, it must hold `-1`.
+ * @ingroup Concurrency
+ */
+OBJECTIVELY_EXPORT void _waitOnce(volatile int *word, int value);
+
+/**
+ * @brief Sets `*word` to `value`, and wakes any threads waiting on it in `_waitOnce`.
+ * @ingroup Concurrency
+ */
+OBJECTIVELY_EXPORT void _wakeOnce(volatile int *word, int value);
 
 /**
  * @brief Executes the given `block` at most one time.
+ * @details Threads that race to execute `block` block until it has completed. Once it has
+ * completed, this costs a single load.
  * @ingroup Concurrency
  */
 #define do_once(once, block) \
-		if (__sync_val_compare_and_swap(once, 0, -1) == 0) { \
-			block; *once = 1; \
-		} else { \
-			while (*once != 1) ; \
+		if (_loadOnce(once) != 1) { \
+			if (__sync_val_compare_and_swap(once, 0, -1) == 0) { \
+				block; _wakeOnce(once, 1); \
+			} else { \
+				_waitOnce(once, 1); \
+			} \
 		}
@@ -23,6 +23,7 @@
 
 #include <assert.h>
 
+#include <Objectively/IndexedArray.h>
 #include <Objectively/Operation.h>
 #include <Objectively/OperationQueue.h>
 
@@ -105,7 +106,7 @@ static Operation *init(Operation *self) {
 		self->locals.condition = $(alloc(Condition), init);
 		assert(self->locals.condition);
 
-		self->locals.dependencies = $(alloc(MutableArray), init);
+		self->locals.dependencies = (MutableArray *) $(alloc(IndexedArray), init);
 		assert(self->locals.dependencies);
 	}
 
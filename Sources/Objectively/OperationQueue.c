@@ -23,6 +23,7 @@
 
 #include <assert.h>
 
+#include <Objectively/IndexedArray.h>
 #include <Objectively/OperationQueue.h>
 
 #define _Class _OperationQueue
@@ -153,7 +154,7 @@ static OperationQueue *init(OperationQueue *self) {
 		self->locals.condition = $(alloc(Condition), init);
 		assert(self->locals.condition);
 
-		self->locals.operations = $(alloc(MutableArray), init);
+		self->locals.operations = (MutableArray *) $(alloc(IndexedArray), init);
 		assert(self->locals.operations);
 
 		self->locals.thread = $(alloc(Thread), initWithFunction, run, self);
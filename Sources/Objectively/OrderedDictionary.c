@@ -0,0 +1,519 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Objectively/Hash.h>
+#include <Objectively/OrderedDictionary.h>
+
+#define _Class _OrderedDictionary
+
+#define ORDEREDDICTIONARY_DEFAULT_CAPACITY 8
+
+/**
+ * @return The index table slot referring to the entry for `key`, or `-1` if `key` is not present.
+ */
+static ssize_t slotForKey(const OrderedDictionary *self, unsigned hash, const ident key) {
+
+	if (self->indexCapacity == 0) {
+		return -1;
+	}
+
+	const size_t mask = self->indexCapacity - 1;
+
+	for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+
+		const unsigned index = self->indices[i];
+		if (index == 0) {
+			return -1;
+		}
+
+		const DictionaryEntry *entry = &self->entries[index - 1];
+		if (entry->hash == hash && (entry->key == key || $((Object *) entry->key, isEqual, key))) {
+			return i;
+		}
+	}
+}
+
+/**
+ * @brief Indexes the entry at `offset`, whose key must not already be indexed.
+ */
+static void indexEntry(OrderedDictionary *self, size_t offset) {
+
+	const size_t mask = self->indexCapacity - 1;
+
+	size_t i = self->entries[offset].hash & mask;
+	while (self->indices[i]) {
+		i = (i + 1) & mask;
+	}
+
+	self->indices[i] = (unsigned) offset + 1;
+}
+
+/**
+ * @brief Compacts the entries of this OrderedDictionary, and reallocates them to `size`.
+ * @details The index table is sized to keep its load below two thirds, and is rebuilt.
+ */
+static void resize(OrderedDictionary *self, size_t size) {
+
+	size_t length = 0;
+
+	for (size_t i = 0; i < self->length; i++) {
+		if (self->entries[i].key) {
+			self->entries[length++] = self->entries[i];
+		}
+	}
+
+	self->length = length;
+
+	assert(size >= length);
+
+	if (size != self->size) {
+		self->entries = realloc(self->entries, size * sizeof(DictionaryEntry));
+		assert(self->entries);
+
+		self->size = size;
+	}
+
+	size_t indexCapacity = 1;
+	while (indexCapacity <= size + (size >> 1)) {
+		indexCapacity <<= 1;
+	}
+
+	if (indexCapacity != self->indexCapacity) {
+		free(self->indices);
+
+		self->indices = calloc(indexCapacity, sizeof(unsigned));
+		assert(self->indices);
+
+		self->indexCapacity = indexCapacity;
+	} else {
+		memset(self->indices, 0, indexCapacity * sizeof(unsigned));
+	}
+
+	for (size_t i = 0; i < length; i++) {
+		indexEntry(self, i);
+	}
+}
+
+#pragma mark - Object
+
+/**
+ * @see Object::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+
+	const Dictionary *this = (Dictionary *) self;
+
+	OrderedDictionary *that = $(alloc(OrderedDictionary), initWithCapacity, this->count);
+
+	$((MutableDictionary *) that, addEntriesFromDictionary, this);
+
+	return (Object *) that;
+}
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	OrderedDictionary *this = (OrderedDictionary *) self;
+
+	for (size_t i = 0; i < this->length; i++) {
+
+		const DictionaryEntry *entry = &this->entries[i];
+		if (entry->key) {
+			release(entry->key);
+			release(entry->object);
+		}
+	}
+
+	free(this->entries);
+	free(this->indices);
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - Dictionary
+
+/**
+ * @see Dictionary::enumerateObjectsAndKeys(const Dictionary *, DictionaryEnumerator, ident)
+ */
+static void enumerateObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		ident data) {
+
+	assert(enumerator);
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	for (size_t i = 0; i < this->length; i++) {
+
+		const DictionaryEntry *entry = &this->entries[i];
+		if (entry->key) {
+
+			if (enumerator(self, entry->object, entry->key, data)) {
+				return;
+			}
+		}
+	}
+}
+
+/**
+ * @see Dictionary::filterObjectsAndKeys(const Dictionary *, DictionaryEnumerator, ident)
+ */
+static Dictionary *filterObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		ident data) {
+
+	assert(enumerator);
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	OrderedDictionary *dictionary = $(alloc(OrderedDictionary), init);
+
+	for (size_t i = 0; i < this->length; i++) {
+
+		const DictionaryEntry *entry = &this->entries[i];
+		if (entry->key) {
+
+			if (enumerator(self, entry->object, entry->key, data)) {
+				$((MutableDictionary *) dictionary, setObjectForKey, entry->object, entry->key);
+			}
+		}
+	}
+
+	return (Dictionary *) dictionary;
+}
+
+/**
+ * @see Dictionary::initWithDictionary(Dictionary *, const Dictionary *)
+ */
+static Dictionary *initWithDictionary(Dictionary *self, const Dictionary *dictionary) {
+
+	OrderedDictionary *this = $((OrderedDictionary *) self, initWithCapacity, dictionary ? dictionary->count : 0);
+	if (this) {
+		if (dictionary) {
+			$((MutableDictionary *) this, addEntriesFromDictionary, dictionary);
+		}
+	}
+
+	return (Dictionary *) this;
+}
+
+/**
+ * @see Dictionary::initWithObjectsForKeysCount(Dictionary *, const ident *, const ident *, size_t)
+ */
+static Dictionary *initWithObjectsForKeysCount(Dictionary *self, const ident *objects, const ident *keys, size_t count) {
+
+	self = (Dictionary *) $((OrderedDictionary *) self, initWithCapacity, count);
+	if (self) {
+		for (size_t i = 0; i < count; i++) {
+			$((MutableDictionary *) self, setObjectForKey, objects[i], keys[i]);
+		}
+	}
+
+	return self;
+}
+
+/**
+ * @see Dictionary::mutableCopy(const Dictionary *)
+ */
+static MutableDictionary *mutableCopy(const Dictionary *self) {
+
+	return (MutableDictionary *) copy((Object *) self);
+}
+
+/**
+ * @see Dictionary::nextObjectAndKey(const Dictionary *, DictionaryIterator *, ident *, ident *)
+ */
+static _Bool nextObjectAndKey(const Dictionary *self, DictionaryIterator *iterator, ident *obj, ident *key) {
+
+	assert(iterator);
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	while (iterator->index < this->length) {
+
+		const DictionaryEntry *entry = &this->entries[iterator->index++];
+		if (entry->key) {
+
+			if (obj) {
+				*obj = entry->object;
+			}
+			if (key) {
+				*key = entry->key;
+			}
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @see Dictionary::objectForKey(const Dictionary *, const ident)
+ */
+static ident objectForKey(const Dictionary *self, const ident key) {
+
+	const OrderedDictionary *this = (OrderedDictionary *) self;
+
+	if (self->count == 0) {
+		return NULL;
+	}
+
+	const unsigned hash = HashFinalize(HashForObject(HASH_SEED, key));
+
+	const ssize_t slot = slotForKey(this, hash, key);
+	if (slot > -1) {
+		return this->entries[this->indices[slot] - 1].object;
+	}
+
+	return NULL;
+}
+
+#pragma mark - MutableDictionary
+
+/**
+ * @see MutableDictionary::removeAllObjects(MutableDictionary *)
+ */
+static void removeAllObjects(MutableDictionary *self) {
+
+	OrderedDictionary *this = (OrderedDictionary *) self;
+
+	for (size_t i = 0; i < this->length; i++) {
+
+		const DictionaryEntry *entry = &this->entries[i];
+		if (entry->key) {
+			release(entry->key);
+			release(entry->object);
+		}
+	}
+
+	if (this->indices) {
+		memset(this->indices, 0, this->indexCapacity * sizeof(unsigned));
+	}
+
+	this->length = 0;
+
+	self->dictionary.count = 0;
+}
+
+/**
+ * @see MutableDictionary::removeObjectForKey(MutableDictionary *, const ident)
+ */
+static void removeObjectForKey(MutableDictionary *self, const ident key) {
+
+	OrderedDictionary *this = (OrderedDictionary *) self;
+
+	if (self->dictionary.count == 0) {
+		return;
+	}
+
+	const unsigned hash = HashFinalize(HashForObject(HASH_SEED, key));
+
+	ssize_t slot = slotForKey(this, hash, key);
+	if (slot == -1) {
+		return;
+	}
+
+	DictionaryEntry *entry = &this->entries[this->indices[slot] - 1];
+
+	release(entry->key);
+	release(entry->object);
+
+	memset(entry, 0, sizeof(*entry));
+
+	while (this->length && this->entries[this->length - 1].key == NULL) {
+		this->length--;
+	}
+
+	// shift the following slots back towards their home slots, so that no tombstone is needed
+
+	const size_t mask = this->indexCapacity - 1;
+	size_t i = slot;
+
+	for (size_t j = (i + 1) & mask; this->indices[j]; j = (j + 1) & mask) {
+
+		const size_t home = this->entries[this->indices[j] - 1].hash & mask;
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			this->indices[i] = this->indices[j];
+			i = j;
+		}
+	}
+
+	this->indices[i] = 0;
+
+	self->dictionary.count--;
+}
+
+/**
+ * @see MutableDictionary::setObjectForKey(MutableDictionary *, const ident, const ident)
+ */
+static void setObjectForKey(MutableDictionary *self, const ident obj, const ident key) {
+
+	assert(obj);
+	assert(key);
+
+	OrderedDictionary *this = (OrderedDictionary *) self;
+
+	const unsigned hash = HashFinalize(HashForObject(HASH_SEED, key));
+
+	const ssize_t slot = slotForKey(this, hash, key);
+	if (slot > -1) {
+
+		DictionaryEntry *entry = &this->entries[this->indices[slot] - 1];
+
+		retain(obj);
+		release(entry->object);
+
+		entry->object = obj;
+		return;
+	}
+
+	if (this->length == this->size) {
+		if (self->dictionary.count < this->length / 2) {
+			resize(this, this->size);
+		} else {
+			resize(this, this->size ? this->size * 2 : ORDEREDDICTIONARY_DEFAULT_CAPACITY);
+		}
+	}
+
+	this->entries[this->length] = (DictionaryEntry) {
+		.key = retain(key),
+		.object = retain(obj),
+		.hash = hash
+	};
+
+	indexEntry(this, this->length++);
+
+	self->dictionary.count++;
+}
+
+#pragma mark - OrderedDictionary
+
+/**
+ * @fn OrderedDictionary *OrderedDictionary::dictionary(void)
+ * @memberof OrderedDictionary
+ */
+static OrderedDictionary *dictionary(void) {
+
+	return $(alloc(OrderedDictionary), init);
+}
+
+/**
+ * @fn OrderedDictionary *OrderedDictionary::dictionaryWithCapacity(size_t capacity)
+ * @memberof OrderedDictionary
+ */
+static OrderedDictionary *dictionaryWithCapacity(size_t capacity) {
+
+	return $(alloc(OrderedDictionary), initWithCapacity, capacity);
+}
+
+/**
+ * @fn OrderedDictionary *OrderedDictionary::init(OrderedDictionary *self)
+ * @memberof OrderedDictionary
+ */
+static OrderedDictionary *init(OrderedDictionary *self) {
+
+	return $(self, initWithCapacity, ORDEREDDICTIONARY_DEFAULT_CAPACITY);
+}
+
+/**
+ * @fn OrderedDictionary *OrderedDictionary::initWithCapacity(OrderedDictionary *self, size_t capacity)
+ * @memberof OrderedDictionary
+ */
+static OrderedDictionary *initWithCapacity(OrderedDictionary *self, size_t capacity) {
+
+	self = (OrderedDictionary *) super(Object, self, init);
+	if (self) {
+		if (capacity) {
+			resize(self, capacity);
+		}
+	}
+
+	return self;
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	ObjectInterface *object = (ObjectInterface *) clazz->def->interface;
+
+	object->copy = copy;
+	object->dealloc = dealloc;
+
+	DictionaryInterface *dict = (DictionaryInterface *) clazz->def->interface;
+
+	dict->enumerateObjectsAndKeys = enumerateObjectsAndKeys;
+	dict->filterObjectsAndKeys = filterObjectsAndKeys;
+	dict->initWithDictionary = initWithDictionary;
+	dict->initWithObjectsForKeysCount = initWithObjectsForKeysCount;
+	dict->mutableCopy = mutableCopy;
+	dict->nextObjectAndKey = nextObjectAndKey;
+	dict->objectForKey = objectForKey;
+
+	MutableDictionaryInterface *mutableDictionary = (MutableDictionaryInterface *) clazz->def->interface;
+
+	mutableDictionary->dictionary = (MutableDictionary *(*)(void)) dictionary;
+	mutableDictionary->dictionaryWithCapacity = (MutableDictionary *(*)(size_t)) dictionaryWithCapacity;
+	mutableDictionary->init = (MutableDictionary *(*)(MutableDictionary *)) init;
+	mutableDictionary->initWithCapacity = (MutableDictionary *(*)(MutableDictionary *, size_t)) initWithCapacity;
+	mutableDictionary->removeAllObjects = removeAllObjects;
+	mutableDictionary->removeObjectForKey = removeObjectForKey;
+	mutableDictionary->setObjectForKey = setObjectForKey;
+
+	OrderedDictionaryInterface *orderedDictionary = (OrderedDictionaryInterface *) clazz->def->interface;
+
+	orderedDictionary->dictionary = dictionary;
+	orderedDictionary->dictionaryWithCapacity = dictionaryWithCapacity;
+	orderedDictionary->init = init;
+	orderedDictionary->initWithCapacity = initWithCapacity;
+}
+
+/**
+ * @fn Class *OrderedDictionary::_OrderedDictionary(void)
+ * @memberof OrderedDictionary
+ */
+Class *_OrderedDictionary(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "OrderedDictionary";
+		clazz.superclass = _MutableDictionary();
+		clazz.instanceSize = sizeof(OrderedDictionary);
+		clazz.interfaceOffset = offsetof(OrderedDictionary, interface);
+		clazz.interfaceSize = sizeof(OrderedDictionaryInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
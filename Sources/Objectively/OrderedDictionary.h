@@ -0,0 +1,147 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <Objectively/MutableDictionary.h>
+
+/**
+ * @file
+ * @brief Mutable key-value stores, which remember the order in which keys were inserted.
+ */
+
+typedef struct OrderedDictionary OrderedDictionary;
+typedef struct OrderedDictionaryInterface OrderedDictionaryInterface;
+
+/**
+ * @brief Mutable key-value stores, which remember the order in which keys were inserted.
+ * @details OrderedDictionary appends its pairs to a dense array, and indexes them with a compact
+ * open-addressed table of array offsets. Enumeration and iteration walk the dense array, so pairs
+ * are visited in insertion order regardless of capacity. Setting an existing key replaces its
+ * Object in place; removing and then setting a key moves it to the end.
+ * @remarks JSONSerialization reads JSON objects into OrderedDictionaries, so that documents are
+ * written back in their original member order.
+ * @extends MutableDictionary
+ * @ingroup Collections
+ */
+struct OrderedDictionary {
+
+	/**
+	 * @brief The superclass.
+	 */
+	MutableDictionary mutableDictionary;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	OrderedDictionaryInterface *interface;
+
+	/**
+	 * @brief The pairs, in insertion order. Removed pairs leave a `NULL` key until compaction.
+	 * @private
+	 */
+	DictionaryEntry *entries;
+
+	/**
+	 * @brief The number of entries in use, including those of removed pairs.
+	 * @private
+	 */
+	size_t length;
+
+	/**
+	 * @brief The number of entries allocated.
+	 * @private
+	 */
+	size_t size;
+
+	/**
+	 * @brief The index table, mapping key hashes to entries. Each slot holds the offset of its
+	 * entry plus one, or zero if it is empty.
+	 * @private
+	 */
+	unsigned *indices;
+
+	/**
+	 * @brief The number of slots in the index table, which is always zero or a power of two.
+	 * @private
+	 */
+	size_t indexCapacity;
+};
+
+/**
+ * @brief The OrderedDictionary interface.
+ */
+struct OrderedDictionaryInterface {
+
+	/**
+	 * @brief The superclass.
+	 */
+	MutableDictionaryInterface mutableDictionaryInterface;
+
+	/**
+	 * @static
+	 * @fn OrderedDictionary *OrderedDictionary::dictionary(void)
+	 * @brief Returns a new OrderedDictionary.
+	 * @return The new OrderedDictionary, or `NULL` on error.
+	 * @memberof OrderedDictionary
+	 */
+	OrderedDictionary *(*dictionary)(void);
+
+	/**
+	 * @static
+	 * @fn OrderedDictionary *OrderedDictionary::dictionaryWithCapacity(size_t capacity)
+	 * @brief Returns a new OrderedDictionary with the given `capacity`.
+	 * @param capacity The desired initial capacity.
+	 * @return The new OrderedDictionary, or `NULL` on error.
+	 * @memberof OrderedDictionary
+	 */
+	OrderedDictionary *(*dictionaryWithCapacity)(size_t capacity);
+
+	/**
+	 * @fn OrderedDictionary *OrderedDictionary::init(OrderedDictionary *self)
+	 * @brief Initializes this OrderedDictionary.
+	 * @param self The OrderedDictionary.
+	 * @return The initialized OrderedDictionary, or `NULL` on error.
+	 * @memberof OrderedDictionary
+	 */
+	OrderedDictionary *(*init)(OrderedDictionary *self);
+
+	/**
+	 * @fn OrderedDictionary *OrderedDictionary::initWithCapacity(OrderedDictionary *self, size_t capacity)
+	 * @brief Initializes this OrderedDictionary with the specified capacity.
+	 * @param self The OrderedDictionary.
+	 * @param capacity The initial capacity.
+	 * @return The initialized OrderedDictionary, or `NULL` on error.
+	 * @memberof OrderedDictionary
+	 */
+	OrderedDictionary *(*initWithCapacity)(OrderedDictionary *self, size_t capacity);
+};
+
+/**
+ * @fn Class *OrderedDictionary::_OrderedDictionary(void)
+ * @brief The OrderedDictionary archetype.
+ * @return The OrderedDictionary Class.
+ * @memberof OrderedDictionary
+ */
+OBJECTIVELY_EXPORT Class *_OrderedDictionary(void);
@@ -0,0 +1,870 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Objectively/Hash.h>
+#include <Objectively/PersistentDictionary.h>
+
+#define _Class _PersistentDictionary
+
+#define PERSISTENTDICTIONARY_BITS 5
+#define PERSISTENTDICTIONARY_MASK ((1u << PERSISTENTDICTIONARY_BITS) - 1)
+#define PERSISTENTDICTIONARY_HASH_BITS 32
+
+typedef struct PersistentDictionaryNode PersistentDictionaryNode;
+
+/**
+ * @brief A node of the trie, which is immutable once published.
+ * @details Each level consumes PERSISTENTDICTIONARY_BITS of the key hash. Entries and child nodes
+ * are stored compactly, and indexed by the population count of their bitmaps. Below the last
+ * level, keys with identical hashes are stored in a collision node, which is searched linearly.
+ */
+struct PersistentDictionaryNode {
+
+	/**
+	 * @brief The number of dictionaries and nodes sharing this node.
+	 */
+	volatile long references;
+
+	/**
+	 * @brief The bitmaps of hash fragments which address an entry, or a child node.
+	 */
+	unsigned entryMap, nodeMap;
+
+	/**
+	 * @brief The number of entries and child nodes.
+	 */
+	unsigned entryCount, nodeCount;
+
+	/**
+	 * @brief The entries, allocated with this node.
+	 */
+	DictionaryEntry *entries;
+
+	/**
+	 * @brief The child nodes, allocated with this node.
+	 */
+	PersistentDictionaryNode **nodes;
+};
+
+/**
+ * @return A new node, with room for the given number of entries and child nodes.
+ */
+static PersistentDictionaryNode *allocNode(unsigned entryCount, unsigned nodeCount) {
+
+	const size_t size = sizeof(PersistentDictionaryNode)
+		+ entryCount * sizeof(DictionaryEntry)
+		+ nodeCount * sizeof(PersistentDictionaryNode *);
+
+	PersistentDictionaryNode *node = calloc(1, size);
+	assert(node);
+
+	node->references = 1;
+	node->entryCount = entryCount;
+	node->nodeCount = nodeCount;
+	node->entries = (DictionaryEntry *) (node + 1);
+	node->nodes = (PersistentDictionaryNode **) (node->entries + entryCount);
+
+	return node;
+}
+
+/**
+ * @brief Atomically retains `node`.
+ */
+static PersistentDictionaryNode *retainNode(const PersistentDictionaryNode *node) {
+
+	PersistentDictionaryNode *that = (PersistentDictionaryNode *) node;
+
+	__sync_add_and_fetch(&that->references, 1);
+
+	return that;
+}
+
+/**
+ * @brief Atomically releases `node`, freeing it and releasing its contents if it is no longer shared.
+ */
+static void releaseNode(PersistentDictionaryNode *node) {
+
+	if (node && __sync_add_and_fetch(&node->references, -1) == 0) {
+
+		for (unsigned i = 0; i < node->entryCount; i++) {
+			release(node->entries[i].key);
+			release(node->entries[i].object);
+		}
+
+		for (unsigned i = 0; i < node->nodeCount; i++) {
+			releaseNode(node->nodes[i]);
+		}
+
+		free(node);
+	}
+}
+
+/**
+ * @brief Retains the contents of a node which was copied from another, skipping empty slots.
+ */
+static void retainContents(PersistentDictionaryNode *node) {
+
+	for (unsigned i = 0; i < node->entryCount; i++) {
+		if (node->entries[i].key) {
+			retain(node->entries[i].key);
+			retain(node->entries[i].object);
+		}
+	}
+
+	for (unsigned i = 0; i < node->nodeCount; i++) {
+		if (node->nodes[i]) {
+			retainNode(node->nodes[i]);
+		}
+	}
+}
+
+/**
+ * @return A copy of `entry`, retaining its key and object.
+ */
+static DictionaryEntry retainEntry(const DictionaryEntry *entry) {
+	return (DictionaryEntry) {
+		.key = retain(entry->key),
+		.object = retain(entry->object),
+		.hash = entry->hash
+	};
+}
+
+/**
+ * @return True if `entry` is for `key`.
+ */
+static inline _Bool isEntryForKey(const DictionaryEntry *entry, unsigned hash, const ident key) {
+	return entry->hash == hash && (entry->key == key || $((Object *) entry->key, isEqual, key));
+}
+
+/**
+ * @return The bitmap bit of `hash` at the level of `shift`.
+ */
+static inline unsigned bitForHash(unsigned hash, unsigned shift) {
+	return 1u << ((hash >> shift) & PERSISTENTDICTIONARY_MASK);
+}
+
+/**
+ * @return The index of `bit` within the compact array addressed by `map`.
+ */
+static inline unsigned indexForBit(unsigned map, unsigned bit) {
+	return __builtin_popcount(map & (bit - 1));
+}
+
+/**
+ * @return A copy of `node`, with `entry` inserted at `index`.
+ */
+static PersistentDictionaryNode *copyAndInsertEntry(const PersistentDictionaryNode *node, unsigned bit,
+		unsigned index, const DictionaryEntry *entry) {
+
+	PersistentDictionaryNode *that = allocNode(node->entryCount + 1, node->nodeCount);
+
+	that->entryMap = node->entryMap | bit;
+	that->nodeMap = node->nodeMap;
+
+	memcpy(that->entries, node->entries, index * sizeof(DictionaryEntry));
+	memcpy(that->entries + index + 1, node->entries + index, (node->entryCount - index) * sizeof(DictionaryEntry));
+	memcpy(that->nodes, node->nodes, node->nodeCount * sizeof(PersistentDictionaryNode *));
+
+	retainContents(that);
+
+	that->entries[index] = retainEntry(entry);
+
+	return that;
+}
+
+/**
+ * @return A copy of `node`, with the entry at `index` replaced by `entry`.
+ */
+static PersistentDictionaryNode *copyAndReplaceEntry(const PersistentDictionaryNode *node, unsigned index,
+		const DictionaryEntry *entry) {
+
+	PersistentDictionaryNode *that = allocNode(node->entryCount, node->nodeCount);
+
+	that->entryMap = node->entryMap;
+	that->nodeMap = node->nodeMap;
+
+	memcpy(that->entries, node->entries, node->entryCount * sizeof(DictionaryEntry));
+	memcpy(that->nodes, node->nodes, node->nodeCount * sizeof(PersistentDictionaryNode *));
+
+	that->entries[index].key = NULL;
+
+	retainContents(that);
+
+	that->entries[index] = retainEntry(entry);
+
+	return that;
+}
+
+/**
+ * @return A copy of `node`, without the entry at `index`.
+ */
+static PersistentDictionaryNode *copyAndRemoveEntry(const PersistentDictionaryNode *node, unsigned bit,
+		unsigned index) {
+
+	PersistentDictionaryNode *that = allocNode(node->entryCount - 1, node->nodeCount);
+
+	that->entryMap = node->entryMap & ~bit;
+	that->nodeMap = node->nodeMap;
+
+	memcpy(that->entries, node->entries, index * sizeof(DictionaryEntry));
+	memcpy(that->entries + index, node->entries + index + 1, (that->entryCount - index) * sizeof(DictionaryEntry));
+	memcpy(that->nodes, node->nodes, node->nodeCount * sizeof(PersistentDictionaryNode *));
+
+	retainContents(that);
+
+	return that;
+}
+
+/**
+ * @return A copy of `node`, with the child node at `index` replaced by `child`, which is adopted.
+ */
+static PersistentDictionaryNode *copyAndReplaceNode(const PersistentDictionaryNode *node, unsigned index,
+		PersistentDictionaryNode *child) {
+
+	PersistentDictionaryNode *that = allocNode(node->entryCount, node->nodeCount);
+
+	that->entryMap = node->entryMap;
+	that->nodeMap = node->nodeMap;
+
+	memcpy(that->entries, node->entries, node->entryCount * sizeof(DictionaryEntry));
+	memcpy(that->nodes, node->nodes, node->nodeCount * sizeof(PersistentDictionaryNode *));
+
+	that->nodes[index] = NULL;
+
+	retainContents(that);
+
+	that->nodes[index] = child;
+
+	return that;
+}
+
+/**
+ * @return A copy of `node`, with the entry at `bit` pushed down into `child`, which is adopted.
+ */
+static PersistentDictionaryNode *copyAndPushEntry(const PersistentDictionaryNode *node, unsigned bit,
+		PersistentDictionaryNode *child) {
+
+	const unsigned entryIndex = indexForBit(node->entryMap, bit);
+	const unsigned nodeIndex = indexForBit(node->nodeMap, bit);
+
+	PersistentDictionaryNode *that = allocNode(node->entryCount - 1, node->nodeCount + 1);
+
+	that->entryMap = node->entryMap & ~bit;
+	that->nodeMap = node->nodeMap | bit;
+
+	memcpy(that->entries, node->entries, entryIndex * sizeof(DictionaryEntry));
+	memcpy(that->entries + entryIndex, node->entries + entryIndex + 1,
+		   (that->entryCount - entryIndex) * sizeof(DictionaryEntry));
+
+	memcpy(that->nodes, node->nodes, nodeIndex * sizeof(PersistentDictionaryNode *));
+	memcpy(that->nodes + nodeIndex + 1, node->nodes + nodeIndex,
+		   (node->nodeCount - nodeIndex) * sizeof(PersistentDictionaryNode *));
+
+	retainContents(that);
+
+	that->nodes[nodeIndex] = child;
+
+	return that;
+}
+
+/**
+ * @return A copy of `node`, with the child node at `bit` pulled up and replaced by `entry`.
+ */
+static PersistentDictionaryNode *copyAndPullEntry(const PersistentDictionaryNode *node, unsigned bit,
+		const DictionaryEntry *entry) {
+
+	const unsigned entryIndex = indexForBit(node->entryMap, bit);
+	const unsigned nodeIndex = indexForBit(node->nodeMap, bit);
+
+	PersistentDictionaryNode *that = allocNode(node->entryCount + 1, node->nodeCount - 1);
+
+	that->entryMap = node->entryMap | bit;
+	that->nodeMap = node->nodeMap & ~bit;
+
+	memcpy(that->entries, node->entries, entryIndex * sizeof(DictionaryEntry));
+	memcpy(that->entries + entryIndex + 1, node->entries + entryIndex,
+		   (node->entryCount - entryIndex) * sizeof(DictionaryEntry));
+
+	memcpy(that->nodes, node->nodes, nodeIndex * sizeof(PersistentDictionaryNode *));
+	memcpy(that->nodes + nodeIndex, node->nodes + nodeIndex + 1,
+		   (that->nodeCount - nodeIndex) * sizeof(PersistentDictionaryNode *));
+
+	retainContents(that);
+
+	that->entries[entryIndex] = retainEntry(entry);
+
+	return that;
+}
+
+/**
+ * @return A new node containing the distinct entries `a` and `b`, at the level of `shift`.
+ */
+static PersistentDictionaryNode *mergeEntries(const DictionaryEntry *a, const DictionaryEntry *b,
+		unsigned shift) {
+
+	PersistentDictionaryNode *node;
+
+	if (shift >= PERSISTENTDICTIONARY_HASH_BITS) {
+		node = allocNode(2, 0);
+		node->entries[0] = retainEntry(a);
+		node->entries[1] = retainEntry(b);
+		return node;
+	}
+
+	const unsigned bitA = bitForHash(a->hash, shift);
+	const unsigned bitB = bitForHash(b->hash, shift);
+
+	if (bitA == bitB) {
+		node = allocNode(0, 1);
+		node->nodeMap = bitA;
+		node->nodes[0] = mergeEntries(a, b, shift + PERSISTENTDICTIONARY_BITS);
+	} else {
+		node = allocNode(2, 0);
+		node->entryMap = bitA | bitB;
+		node->entries[bitA < bitB ? 0 : 1] = retainEntry(a);
+		node->entries[bitA < bitB ? 1 : 0] = retainEntry(b);
+	}
+
+	return node;
+}
+
+/**
+ * @brief Looks up the entry for `key` beneath `node`.
+ */
+static const DictionaryEntry *entryForKey(const PersistentDictionaryNode *node, unsigned hash,
+		const ident key) {
+
+	unsigned shift = 0;
+
+	while (node) {
+
+		if (shift >= PERSISTENTDICTIONARY_HASH_BITS) {
+			for (unsigned i = 0; i < node->entryCount; i++) {
+				if (isEntryForKey(&node->entries[i], hash, key)) {
+					return &node->entries[i];
+				}
+			}
+			break;
+		}
+
+		const unsigned bit = bitForHash(hash, shift);
+
+		if (node->entryMap & bit) {
+			const DictionaryEntry *entry = &node->entries[indexForBit(node->entryMap, bit)];
+			return isEntryForKey(entry, hash, key) ? entry : NULL;
+		}
+
+		if (node->nodeMap & bit) {
+			node = node->nodes[indexForBit(node->nodeMap, bit)];
+			shift += PERSISTENTDICTIONARY_BITS;
+		} else {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @return A copy of `node` with `entry` set, sharing every unchanged child node.
+ */
+static PersistentDictionaryNode *setEntry(const PersistentDictionaryNode *node,
+		const DictionaryEntry *entry, unsigned shift, _Bool *added) {
+
+	if (shift >= PERSISTENTDICTIONARY_HASH_BITS) {
+		for (unsigned i = 0; i < node->entryCount; i++) {
+			if (isEntryForKey(&node->entries[i], entry->hash, entry->key)) {
+				return copyAndReplaceEntry(node, i, entry);
+			}
+		}
+
+		*added = true;
+		return copyAndInsertEntry(node, 0, node->entryCount, entry);
+	}
+
+	const unsigned bit = bitForHash(entry->hash, shift);
+
+	if (node->entryMap & bit) {
+
+		const unsigned index = indexForBit(node->entryMap, bit);
+		const DictionaryEntry *existing = &node->entries[index];
+
+		if (isEntryForKey(existing, entry->hash, entry->key)) {
+			if (existing->object == entry->object) {
+				return retainNode(node);
+			}
+			return copyAndReplaceEntry(node, index, entry);
+		}
+
+		*added = true;
+		return copyAndPushEntry(node, bit, mergeEntries(existing, entry, shift + PERSISTENTDICTIONARY_BITS));
+	}
+
+	if (node->nodeMap & bit) {
+
+		const unsigned index = indexForBit(node->nodeMap, bit);
+		PersistentDictionaryNode *child = setEntry(node->nodes[index], entry, shift + PERSISTENTDICTIONARY_BITS, added);
+
+		if (child == node->nodes[index]) {
+			releaseNode(child);
+			return retainNode(node);
+		}
+
+		return copyAndReplaceNode(node, index, child);
+	}
+
+	*added = true;
+	return copyAndInsertEntry(node, bit, indexForBit(node->entryMap, bit), entry);
+}
+
+/**
+ * @return A copy of `node` without the entry for `key`, or `NULL` if the copy would be empty.
+ * @remarks Child nodes left with a single entry are pulled up into their parent, so that the trie
+ * remains compact. If `key` is not found, `removed` is not set and `NULL` is returned.
+ */
+static PersistentDictionaryNode *removeEntry(const PersistentDictionaryNode *node, unsigned hash,
+		const ident key, unsigned shift, _Bool *removed) {
+
+	if (shift >= PERSISTENTDICTIONARY_HASH_BITS) {
+		for (unsigned i = 0; i < node->entryCount; i++) {
+			if (isEntryForKey(&node->entries[i], hash, key)) {
+				*removed = true;
+				return node->entryCount > 1 ? copyAndRemoveEntry(node, 0, i) : NULL;
+			}
+		}
+		return NULL;
+	}
+
+	const unsigned bit = bitForHash(hash, shift);
+
+	if (node->entryMap & bit) {
+
+		const unsigned index = indexForBit(node->entryMap, bit);
+		if (isEntryForKey(&node->entries[index], hash, key) == false) {
+			return NULL;
+		}
+
+		*removed = true;
+
+		if (node->entryCount == 1 && node->nodeCount == 0) {
+			return NULL;
+		}
+
+		return copyAndRemoveEntry(node, bit, index);
+	}
+
+	if (node->nodeMap & bit) {
+
+		const unsigned index = indexForBit(node->nodeMap, bit);
+		PersistentDictionaryNode *child = removeEntry(node->nodes[index], hash, key, shift + PERSISTENTDICTIONARY_BITS, removed);
+
+		if (*removed == false) {
+			return NULL;
+		}
+
+		assert(child);
+
+		if (child->entryCount == 1 && child->nodeCount == 0) {
+			PersistentDictionaryNode *that = copyAndPullEntry(node, bit, &child->entries[0]);
+			releaseNode(child);
+			return that;
+		}
+
+		return copyAndReplaceNode(node, index, child);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Enumerates the entries beneath `node`.
+ * @return True if enumeration was stopped by `enumerator`.
+ */
+static _Bool enumerateNode(const PersistentDictionaryNode *node, const Dictionary *dictionary,
+		DictionaryEnumerator enumerator, ident data) {
+
+	for (unsigned i = 0; i < node->entryCount; i++) {
+		if (enumerator(dictionary, node->entries[i].object, node->entries[i].key, data)) {
+			return true;
+		}
+	}
+
+	for (unsigned i = 0; i < node->nodeCount; i++) {
+		if (enumerateNode(node->nodes[i], dictionary, enumerator, data)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Sets `obj` for `key` in this PersistentDictionary, which must not yet be published.
+ */
+static void setObjectForKey(PersistentDictionary *self, const ident obj, const ident key) {
+
+	assert(obj);
+	assert(key);
+
+	const DictionaryEntry entry = {
+		.key = key,
+		.object = obj,
+		.hash = HashFinalize(HashForObject(HASH_SEED, key))
+	};
+
+	PersistentDictionaryNode *root;
+	_Bool added = false;
+
+	if (self->root) {
+		root = setEntry(self->root, &entry, 0, &added);
+		releaseNode(self->root);
+	} else {
+		root = allocNode(1, 0);
+		root->entryMap = bitForHash(entry.hash, 0);
+		root->entries[0] = retainEntry(&entry);
+		added = true;
+	}
+
+	self->root = root;
+
+	if (added) {
+		self->dictionary.count++;
+	}
+}
+
+#pragma mark - Object
+
+/**
+ * @see Object::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+
+	const Dictionary *this = (Dictionary *) self;
+
+	PersistentDictionary *that = (PersistentDictionary *) $((Dictionary *) alloc(PersistentDictionary),
+			initWithDictionary, this);
+
+	return (Object *) that;
+}
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	PersistentDictionary *this = (PersistentDictionary *) self;
+
+	releaseNode(this->root);
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - Dictionary
+
+/**
+ * @see Dictionary::enumerateObjectsAndKeys(const Dictionary *, DictionaryEnumerator, ident)
+ */
+static void enumerateObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		ident data) {
+
+	assert(enumerator);
+
+	const PersistentDictionary *this = (PersistentDictionary *) self;
+
+	if (this->root) {
+		enumerateNode(this->root, self, enumerator, data);
+	}
+}
+
+/**
+ * @brief The state of filterObjectsAndKeys.
+ */
+typedef struct {
+	PersistentDictionary *dictionary;
+	DictionaryEnumerator enumerator;
+	ident data;
+} FilterObjectsAndKeys;
+
+/**
+ * @brief A DictionaryEnumerator for filterObjectsAndKeys.
+ */
+static _Bool filterObjectsAndKeys_enumerator(const Dictionary *dict, ident obj, ident key, ident data) {
+
+	FilterObjectsAndKeys *filter = (FilterObjectsAndKeys *) data;
+
+	if (filter->enumerator(dict, obj, key, filter->data)) {
+		setObjectForKey(filter->dictionary, obj, key);
+	}
+
+	return false;
+}
+
+/**
+ * @see Dictionary::filterObjectsAndKeys(const Dictionary *, DictionaryEnumerator, ident)
+ */
+static Dictionary *filterObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		ident data) {
+
+	assert(enumerator);
+
+	FilterObjectsAndKeys filter = {
+		.dictionary = $(alloc(PersistentDictionary), init),
+		.enumerator = enumerator,
+		.data = data
+	};
+
+	$(self, enumerateObjectsAndKeys, filterObjectsAndKeys_enumerator, &filter);
+
+	return (Dictionary *) filter.dictionary;
+}
+
+/**
+ * @brief A DictionaryEnumerator for initWithDictionary.
+ */
+static _Bool initWithDictionary_enumerator(const Dictionary *dict, ident obj, ident key, ident data) {
+
+	setObjectForKey((PersistentDictionary *) data, obj, key);
+
+	return false;
+}
+
+/**
+ * @see Dictionary::initWithDictionary(Dictionary *, const Dictionary *)
+ * @remarks If `dictionary` is itself a PersistentDictionary, its trie is shared.
+ */
+static Dictionary *initWithDictionary(Dictionary *self, const Dictionary *dictionary) {
+
+	PersistentDictionary *this = $((PersistentDictionary *) self, init);
+	if (this) {
+		if (dictionary) {
+			if ($((Object *) dictionary, isKindOfClass, _PersistentDictionary())) {
+
+				const PersistentDictionary *that = (PersistentDictionary *) dictionary;
+				if (that->root) {
+					this->root = retainNode(that->root);
+					this->dictionary.count = dictionary->count;
+				}
+			} else {
+				$(dictionary, enumerateObjectsAndKeys, initWithDictionary_enumerator, this);
+			}
+		}
+	}
+
+	return (Dictionary *) this;
+}
+
+/**
+ * @see Dictionary::initWithObjectsForKeysCount(Dictionary *, const ident *, const ident *, size_t)
+ */
+static Dictionary *initWithObjectsForKeysCount(Dictionary *self, const ident *objects, const ident *keys, size_t count) {
+
+	self = (Dictionary *) $((PersistentDictionary *) self, init);
+	if (self) {
+		for (size_t i = 0; i < count; i++) {
+			setObjectForKey((PersistentDictionary *) self, objects[i], keys[i]);
+		}
+	}
+
+	return self;
+}
+
+/**
+ * @see Dictionary::iterator(const Dictionary *)
+ */
+static DictionaryIterator iterator(const Dictionary *self) {
+
+	const PersistentDictionary *this = (PersistentDictionary *) self;
+
+	DictionaryIterator iterator = {
+		.index = 0
+	};
+
+	if (this->root) {
+		iterator.nodes[iterator.depth++] = this->root;
+	}
+
+	return iterator;
+}
+
+/**
+ * @see Dictionary::nextObjectAndKey(const Dictionary *, DictionaryIterator *, ident *, ident *)
+ * @remarks The trie is walked depth first, so the node stack never exceeds its depth.
+ */
+static _Bool nextObjectAndKey(const Dictionary *self, DictionaryIterator *iterator, ident *obj, ident *key) {
+
+	assert(iterator);
+
+	while (iterator->depth) {
+
+		const PersistentDictionaryNode *node = iterator->nodes[iterator->depth - 1];
+		const unsigned position = iterator->positions[iterator->depth - 1]++;
+
+		if (position < node->entryCount) {
+
+			if (obj) {
+				*obj = node->entries[position].object;
+			}
+			if (key) {
+				*key = node->entries[position].key;
+			}
+
+			return true;
+		}
+
+		if (position < node->entryCount + node->nodeCount) {
+
+			assert(iterator->depth < DICTIONARY_ITERATOR_DEPTH);
+
+			iterator->nodes[iterator->depth] = node->nodes[position - node->entryCount];
+			iterator->positions[iterator->depth] = 0;
+			iterator->depth++;
+		} else {
+			iterator->depth--;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @see Dictionary::objectForKey(const Dictionary *, const ident)
+ */
+static ident objectForKey(const Dictionary *self, const ident key) {
+
+	const PersistentDictionary *this = (PersistentDictionary *) self;
+
+	const unsigned hash = HashFinalize(HashForObject(HASH_SEED, key));
+	const DictionaryEntry *entry = entryForKey(this->root, hash, key);
+
+	return entry ? entry->object : NULL;
+}
+
+#pragma mark - PersistentDictionary
+
+/**
+ * @fn PersistentDictionary *PersistentDictionary::dictionaryByRemovingObjectForKey(const PersistentDictionary *self, const ident key)
+ * @memberof PersistentDictionary
+ */
+static PersistentDictionary *dictionaryByRemovingObjectForKey(const PersistentDictionary *self,
+		const ident key) {
+
+	PersistentDictionary *that = $(alloc(PersistentDictionary), init);
+	if (that) {
+
+		_Bool removed = false;
+
+		if (self->root) {
+			const unsigned hash = HashFinalize(HashForObject(HASH_SEED, key));
+			that->root = removeEntry(self->root, hash, key, 0, &removed);
+		}
+
+		if (removed) {
+			that->dictionary.count = self->dictionary.count - 1;
+		} else if (self->root) {
+			that->root = retainNode(self->root);
+			that->dictionary.count = self->dictionary.count;
+		}
+	}
+
+	return that;
+}
+
+/**
+ * @fn PersistentDictionary *PersistentDictionary::dictionaryBySettingObjectForKey(const PersistentDictionary *self, const ident obj, const ident key)
+ * @memberof PersistentDictionary
+ */
+static PersistentDictionary *dictionaryBySettingObjectForKey(const PersistentDictionary *self,
+		const ident obj, const ident key) {
+
+	PersistentDictionary *that = (PersistentDictionary *) $((Dictionary *) alloc(PersistentDictionary),
+			initWithDictionary, (Dictionary *) self);
+	if (that) {
+		setObjectForKey(that, obj, key);
+	}
+
+	return that;
+}
+
+/**
+ * @fn PersistentDictionary *PersistentDictionary::init(PersistentDictionary *self)
+ * @memberof PersistentDictionary
+ */
+static PersistentDictionary *init(PersistentDictionary *self) {
+
+	return (PersistentDictionary *) super(Object, self, init);
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	ObjectInterface *object = (ObjectInterface *) clazz->def->interface;
+
+	object->copy = copy;
+	object->dealloc = dealloc;
+
+	DictionaryInterface *dictionary = (DictionaryInterface *) clazz->def->interface;
+
+	dictionary->enumerateObjectsAndKeys = enumerateObjectsAndKeys;
+	dictionary->filterObjectsAndKeys = filterObjectsAndKeys;
+	dictionary->initWithDictionary = initWithDictionary;
+	dictionary->initWithObjectsForKeysCount = initWithObjectsForKeysCount;
+	dictionary->iterator = iterator;
+	dictionary->nextObjectAndKey = nextObjectAndKey;
+	dictionary->objectForKey = objectForKey;
+
+	PersistentDictionaryInterface *persistentDictionary = (PersistentDictionaryInterface *) clazz->def->interface;
+
+	persistentDictionary->dictionaryByRemovingObjectForKey = dictionaryByRemovingObjectForKey;
+	persistentDictionary->dictionaryBySettingObjectForKey = dictionaryBySettingObjectForKey;
+	persistentDictionary->init = init;
+}
+
+/**
+ * @fn Class *PersistentDictionary::_PersistentDictionary(void)
+ * @memberof PersistentDictionary
+ */
+Class *_PersistentDictionary(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "PersistentDictionary";
+		clazz.superclass = _Dictionary();
+		clazz.instanceSize = sizeof(PersistentDictionary);
+		clazz.interfaceOffset = offsetof(PersistentDictionary, interface);
+		clazz.interfaceSize = sizeof(PersistentDictionaryInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
@@ -0,0 +1,112 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <Objectively/Dictionary.h>
+
+/**
+ * @file
+ * @brief Persistent key-value stores, which share structure between versions.
+ */
+
+typedef struct PersistentDictionary PersistentDictionary;
+typedef struct PersistentDictionaryInterface PersistentDictionaryInterface;
+
+/**
+ * @brief Persistent key-value stores, which share structure between versions.
+ * @details PersistentDictionary stores its pairs in a hash array mapped trie. Rather than
+ * modifying the receiver, `dictionaryBySettingObjectForKey` and `dictionaryByRemovingObjectForKey`
+ * return a new PersistentDictionary which shares every unchanged node of the trie with the receiver.
+ * Updates therefore cost `O(log32 n)` rather than `O(n)`, and copies are constant time.
+ * @remarks Nodes are immutable and atomically reference counted, so a PersistentDictionary may be
+ * published to, and read by, other threads without locking.
+ * @extends Dictionary
+ * @ingroup Collections
+ */
+struct PersistentDictionary {
+
+	/**
+	 * @brief The superclass.
+	 */
+	Dictionary dictionary;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	PersistentDictionaryInterface *interface;
+
+	/**
+	 * @brief The root node of the trie, or `NULL` if this PersistentDictionary is empty.
+	 * @private
+	 */
+	ident root;
+};
+
+/**
+ * @brief The PersistentDictionary interface.
+ */
+struct PersistentDictionaryInterface {
+
+	/**
+	 * @brief The superclass.
+	 */
+	DictionaryInterface dictionaryInterface;
+
+	/**
+	 * @fn PersistentDictionary *PersistentDictionary::dictionaryByRemovingObjectForKey(const PersistentDictionary *self, const ident key)
+	 * @param self The PersistentDictionary.
+	 * @param key The key to remove.
+	 * @return A new PersistentDictionary with the pairs of this one, less `key`.
+	 * @memberof PersistentDictionary
+	 */
+	PersistentDictionary *(*dictionaryByRemovingObjectForKey)(const PersistentDictionary *self, const ident key);
+
+	/**
+	 * @fn PersistentDictionary *PersistentDictionary::dictionaryBySettingObjectForKey(const PersistentDictionary *self, const ident obj, const ident key)
+	 * @param self The PersistentDictionary.
+	 * @param obj The Object to set.
+	 * @param key The key of the Object to set.
+	 * @return A new PersistentDictionary with the pairs of this one, and `obj` set for `key`.
+	 * @memberof PersistentDictionary
+	 */
+	PersistentDictionary *(*dictionaryBySettingObjectForKey)(const PersistentDictionary *self, const ident obj, const ident key);
+
+	/**
+	 * @fn PersistentDictionary *PersistentDictionary::init(PersistentDictionary *self)
+	 * @brief Initializes this PersistentDictionary.
+	 * @param self The PersistentDictionary.
+	 * @return The initialized, empty PersistentDictionary, or `NULL` on error.
+	 * @memberof PersistentDictionary
+	 */
+	PersistentDictionary *(*init)(PersistentDictionary *self);
+};
+
+/**
+ * @fn Class *PersistentDictionary::_PersistentDictionary(void)
+ * @brief The PersistentDictionary archetype.
+ * @return The PersistentDictionary Class.
+ * @memberof PersistentDictionary
+ */
+OBJECTIVELY_EXPORT Class *_PersistentDictionary(void);
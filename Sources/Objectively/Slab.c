@@ -0,0 +1,374 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#include <Objectively/Slab.h>
+
+/**
+ * @brief Blocks are aligned to this boundary.
+ */
+#define SLAB_ALIGNMENT 16
+
+typedef struct Chunk Chunk;
+typedef struct Magazine Magazine;
+
+/**
+ * @brief Chunks are the backing memory from which blocks are carved.
+ */
+struct Chunk {
+
+	/**
+	 * @brief The next Chunk.
+	 */
+	Chunk *next;
+};
+
+/**
+ * @brief Magazines are stacks of free blocks.
+ */
+struct Magazine {
+
+	/**
+	 * @brief The next Magazine in the depot.
+	 */
+	Magazine *next;
+
+	/**
+	 * @brief The count of blocks.
+	 */
+	size_t count;
+
+	/**
+	 * @brief The blocks.
+	 */
+	ident blocks[SLAB_MAGAZINE_SIZE];
+};
+
+struct Slab {
+
+	/**
+	 * @brief The block size, rounded up to `SLAB_ALIGNMENT`.
+	 */
+	size_t size;
+
+	/**
+	 * @brief The index of this Slab's Magazine in each thread's Cache.
+	 */
+	size_t index;
+
+	/**
+	 * @brief The lock, which guards the depot and the Chunks.
+	 */
+	pthread_mutex_t lock;
+
+	/**
+	 * @brief The depot of full Magazines.
+	 */
+	Magazine *full;
+
+	/**
+	 * @brief The depot of empty Magazines.
+	 */
+	Magazine *empty;
+
+	/**
+	 * @brief The Chunks.
+	 */
+	Chunk *chunks;
+
+	/**
+	 * @brief The unused region of the most recent Chunk.
+	 */
+	uint8_t *cursor, *limit;
+};
+
+/**
+ * @brief Each thread's Magazines, indexed by Slab.
+ */
+typedef struct {
+
+	/**
+	 * @brief The Magazines.
+	 */
+	Magazine **magazines;
+
+	/**
+	 * @brief The count of Magazines.
+	 */
+	size_t count;
+} Cache;
+
+static pthread_mutex_t _lock = PTHREAD_MUTEX_INITIALIZER;
+
+static Slab **_slabs;
+static size_t _count;
+
+static pthread_key_t _key;
+static pthread_once_t _once = PTHREAD_ONCE_INIT;
+
+static __thread Cache *_cache;
+
+/**
+ * @brief Returns the exiting thread's Magazines to their Slabs' depots.
+ * @remarks Blocks freed by destructors that run after this one are cached anew, and that Cache is
+ * in turn released by a subsequent destructor iteration.
+ */
+static void releaseCache(ident data) {
+
+	Cache *cache = (Cache *) data;
+
+	if (_cache == cache) {
+		_cache = NULL;
+	}
+
+	pthread_mutex_lock(&_lock);
+
+	for (size_t i = 0; i < cache->count; i++) {
+
+		Magazine *magazine = cache->magazines[i];
+		if (magazine) {
+
+			Slab *slab = i < _count ? _slabs[i] : NULL;
+			if (slab) {
+				pthread_mutex_lock(&slab->lock);
+
+				if (magazine->count) {
+					magazine->next = slab->full;
+					slab->full = magazine;
+				} else {
+					magazine->next = slab->empty;
+					slab->empty = magazine;
+				}
+
+				pthread_mutex_unlock(&slab->lock);
+			} else {
+				free(magazine);
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&_lock);
+
+	free(cache->magazines);
+	free(cache);
+}
+
+/**
+ * @brief Creates the key through which Caches are released.
+ */
+static void createKey(void) {
+
+	const int err = pthread_key_create(&_key, releaseCache);
+	assert(err == 0);
+}
+
+/**
+ * @return The calling thread's Magazine for the given Slab.
+ */
+static Magazine **magazine(const Slab *slab) {
+
+	Cache *cache = _cache;
+
+	if (cache == NULL || cache->count <= slab->index) {
+
+		if (cache == NULL) {
+			cache = _cache = calloc(1, sizeof(Cache));
+			assert(cache);
+
+			pthread_once(&_once, createKey);
+			pthread_setspecific(_key, cache);
+		}
+
+		const size_t count = slab->index + 1;
+
+		cache->magazines = realloc(cache->magazines, count * sizeof(Magazine *));
+		assert(cache->magazines);
+
+		memset(cache->magazines + cache->count, 0, (count - cache->count) * sizeof(Magazine *));
+		cache->count = count;
+	}
+
+	Magazine **magazine = &cache->magazines[slab->index];
+	if (*magazine == NULL) {
+		*magazine = calloc(1, sizeof(Magazine));
+		assert(*magazine);
+	}
+
+	return magazine;
+}
+
+/**
+ * @brief Refills the given empty Magazine, either from the depot or from a Chunk.
+ */
+static void refill(Slab *slab, Magazine **magazine) {
+
+	pthread_mutex_lock(&slab->lock);
+
+	if (slab->full) {
+		Magazine *full = slab->full;
+		slab->full = full->next;
+
+		(*magazine)->next = slab->empty;
+		slab->empty = *magazine;
+
+		*magazine = full;
+	} else {
+		Magazine *mag = *magazine;
+
+		while (mag->count < SLAB_MAGAZINE_SIZE) {
+
+			if (slab->cursor + slab->size > slab->limit) {
+
+				const size_t size = max((size_t) SLAB_CHUNK_SIZE, SLAB_ALIGNMENT + slab->size * SLAB_MAGAZINE_SIZE);
+
+				Chunk *chunk = malloc(size);
+				assert(chunk);
+
+				chunk->next = slab->chunks;
+				slab->chunks = chunk;
+
+				slab->cursor = (uint8_t *) chunk + SLAB_ALIGNMENT;
+				slab->limit = (uint8_t *) chunk + size;
+			}
+
+			mag->blocks[mag->count++] = slab->cursor;
+			slab->cursor += slab->size;
+		}
+	}
+
+	pthread_mutex_unlock(&slab->lock);
+}
+
+Slab *SlabCreate(size_t size) {
+
+	assert(size);
+
+	Slab *slab = calloc(1, sizeof(Slab));
+	assert(slab);
+
+	slab->size = (size + SLAB_ALIGNMENT - 1) & ~((size_t) SLAB_ALIGNMENT - 1);
+
+	const int err = pthread_mutex_init(&slab->lock, NULL);
+	assert(err == 0);
+
+	pthread_mutex_lock(&_lock);
+
+	slab->index = _count++;
+
+	_slabs = realloc(_slabs, _count * sizeof(Slab *));
+	assert(_slabs);
+
+	_slabs[slab->index] = slab;
+
+	pthread_mutex_unlock(&_lock);
+
+	return slab;
+}
+
+ident SlabAllocate(Slab *slab) {
+
+	Magazine **mag = magazine(slab);
+
+	if ((*mag)->count == 0) {
+		refill(slab, mag);
+	}
+
+	ident block = (*mag)->blocks[--(*mag)->count];
+
+	memset(block, 0, slab->size);
+
+	return block;
+}
+
+void SlabFree(Slab *slab, ident block) {
+
+	assert(block);
+
+	Magazine **mag = magazine(slab);
+
+	if ((*mag)->count == SLAB_MAGAZINE_SIZE) {
+
+		pthread_mutex_lock(&slab->lock);
+
+		(*mag)->next = slab->full;
+		slab->full = *mag;
+
+		*mag = slab->empty;
+		if (*mag) {
+			slab->empty = (*mag)->next;
+		}
+
+		pthread_mutex_unlock(&slab->lock);
+
+		if (*mag == NULL) {
+			*mag = malloc(sizeof(Magazine));
+			assert(*mag);
+		}
+
+		(*mag)->count = 0;
+	}
+
+	(*mag)->blocks[(*mag)->count++] = block;
+}
+
+void SlabDestroy(Slab *slab) {
+
+	assert(slab);
+
+	pthread_mutex_lock(&_lock);
+	_slabs[slab->index] = NULL;
+	pthread_mutex_unlock(&_lock);
+
+	if (_cache && slab->index < _cache->count) {
+		free(_cache->magazines[slab->index]);
+		_cache->magazines[slab->index] = NULL;
+	}
+
+	Magazine *depots[] = { slab->full, slab->empty };
+	for (size_t i = 0; i < lengthof(depots); i++) {
+
+		Magazine *mag = depots[i];
+		while (mag) {
+			Magazine *next = mag->next;
+			free(mag);
+			mag = next;
+		}
+	}
+
+	Chunk *chunk = slab->chunks;
+	while (chunk) {
+		Chunk *next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+
+	pthread_mutex_destroy(&slab->lock);
+
+	free(slab);
+}
@@ -0,0 +1,81 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#pragma once
+
+#include <Objectively/Types.h>
+
+/**
+ * @file
+ * @brief Fixed-size block allocation with thread-local magazines.
+ * @ingroup Core
+ */
+
+/**
+ * @brief The number of blocks held by each thread-local magazine.
+ */
+#define SLAB_MAGAZINE_SIZE 64
+
+/**
+ * @brief The minimum size, in bytes, of the chunks from which blocks are carved.
+ */
+#define SLAB_CHUNK_SIZE 0x10000
+
+/**
+ * @brief Slabs allocate fixed-size blocks of memory.
+ * @details Each thread draws blocks from, and returns blocks to, its own magazine, so that the
+ * common case requires no locking. Magazines are exchanged with the Slab's depot only when they
+ * become empty or full.
+ * @remarks Blocks are never returned to the system until the Slab is destroyed.
+ * @ingroup Core
+ */
+typedef struct Slab Slab;
+
+/**
+ * @brief Creates a new Slab for blocks of `size` bytes.
+ * @param size The block size.
+ * @return The new Slab.
+ */
+OBJECTIVELY_EXPORT Slab *SlabCreate(size_t size);
+
+/**
+ * @brief Allocates a zero-filled block from the given Slab.
+ * @param slab The Slab.
+ * @return The block.
+ */
+OBJECTIVELY_EXPORT ident SlabAllocate(Slab *slab);
+
+/**
+ * @brief Returns the given block to the Slab.
+ * @param slab The Slab.
+ * @param block A block previously allocated from `slab`.
+ */
+OBJECTIVELY_EXPORT void SlabFree(Slab *slab, ident block);
+
+/**
+ * @brief Destroys the given Slab, freeing all of its memory.
+ * @param slab The Slab.
+ * @remarks Any outstanding blocks are invalidated.
+ */
+OBJECTIVELY_EXPORT void SlabDestroy(Slab *slab);
@@ -0,0 +1,1066 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Objectively/MutableArray.h>
+#include <Objectively/SortedDictionary.h>
+
+#define _Class _SortedDictionary
+
+#define SORTEDDICTIONARY_ORDER 32
+
+typedef struct SortedDictionaryNode SortedDictionaryNode;
+typedef struct SortedDictionaryLeaf SortedDictionaryLeaf;
+typedef struct SortedDictionaryBranch SortedDictionaryBranch;
+
+/**
+ * @brief The header common to leaves and branches of the tree.
+ * @details Keys are retained by every node which holds them, including the branches which hold
+ * them as separators.
+ */
+struct SortedDictionaryNode {
+
+	/**
+	 * @brief The number of keys.
+	 */
+	unsigned count;
+
+	/**
+	 * @brief True if this node is a leaf.
+	 */
+	_Bool leaf;
+
+	/**
+	 * @brief The keys, in ascending order.
+	 */
+	ident keys[SORTEDDICTIONARY_ORDER];
+};
+
+/**
+ * @brief A leaf of the tree, which holds pairs and is linked to its neighbors.
+ */
+struct SortedDictionaryLeaf {
+
+	/**
+	 * @brief The node.
+	 */
+	SortedDictionaryNode node;
+
+	/**
+	 * @brief The Objects, parallel to the keys.
+	 */
+	ident objects[SORTEDDICTIONARY_ORDER];
+
+	/**
+	 * @brief The neighboring leaves.
+	 */
+	SortedDictionaryLeaf *prev, *next;
+};
+
+/**
+ * @brief A branch of the tree. Child `i` holds the keys between separators `i - 1` and `i`.
+ */
+struct SortedDictionaryBranch {
+
+	/**
+	 * @brief The node, whose keys are the separators.
+	 */
+	SortedDictionaryNode node;
+
+	/**
+	 * @brief The children, one more than the separators.
+	 */
+	SortedDictionaryNode *children[SORTEDDICTIONARY_ORDER + 1];
+};
+
+/**
+ * @return A new, empty leaf.
+ */
+static SortedDictionaryLeaf *allocLeaf(void) {
+
+	SortedDictionaryLeaf *leaf = calloc(1, sizeof(SortedDictionaryLeaf));
+	assert(leaf);
+
+	leaf->node.leaf = true;
+
+	return leaf;
+}
+
+/**
+ * @return A new, empty branch.
+ */
+static SortedDictionaryBranch *allocBranch(void) {
+
+	SortedDictionaryBranch *branch = calloc(1, sizeof(SortedDictionaryBranch));
+	assert(branch);
+
+	return branch;
+}
+
+/**
+ * @brief Frees `node` and its descendants, releasing their keys and Objects.
+ */
+static void freeNode(SortedDictionaryNode *node) {
+
+	for (unsigned i = 0; i < node->count; i++) {
+		release(node->keys[i]);
+	}
+
+	if (node->leaf) {
+		const SortedDictionaryLeaf *leaf = (SortedDictionaryLeaf *) node;
+		for (unsigned i = 0; i < node->count; i++) {
+			release(leaf->objects[i]);
+		}
+	} else {
+		const SortedDictionaryBranch *branch = (SortedDictionaryBranch *) node;
+		for (unsigned i = 0; i <= node->count; i++) {
+			freeNode(branch->children[i]);
+		}
+	}
+
+	free(node);
+}
+
+/**
+ * @brief Binary searches `node` for `key`.
+ * @return The index of the first key which is not less than `key`.
+ */
+static unsigned search(const SortedDictionary *self, const SortedDictionaryNode *node, const ident key,
+		_Bool *found) {
+
+	unsigned low = 0, high = node->count;
+
+	while (low < high) {
+
+		const unsigned mid = (low + high) >> 1;
+
+		const Order order = self->comparator(node->keys[mid], key);
+		if (order == OrderAscending) {
+			low = mid + 1;
+		} else if (order == OrderDescending) {
+			high = mid;
+		} else {
+			*found = true;
+			return mid;
+		}
+	}
+
+	*found = false;
+	return low;
+}
+
+/**
+ * @return The index of the child of `branch` which would hold `key`.
+ */
+static unsigned childIndex(const SortedDictionary *self, const SortedDictionaryBranch *branch, const ident key) {
+
+	_Bool found;
+	const unsigned i = search(self, &branch->node, key, &found);
+
+	return found ? i + 1 : i;
+}
+
+/**
+ * @brief Descends the tree to the leaf which would hold `key`.
+ * @return The leaf, and the index of the first key in it which is not less than `key`.
+ */
+static SortedDictionaryLeaf *leafForKey(const SortedDictionary *self, const ident key, unsigned *index,
+		_Bool *found) {
+
+	SortedDictionaryNode *node = self->root;
+	if (node == NULL) {
+		return NULL;
+	}
+
+	while (node->leaf == false) {
+		const SortedDictionaryBranch *branch = (SortedDictionaryBranch *) node;
+		node = branch->children[childIndex(self, branch, key)];
+	}
+
+	*index = search(self, node, key, found);
+
+	return (SortedDictionaryLeaf *) node;
+}
+
+/**
+ * @brief Opens a gap at `index` in the `count` elements of `array`.
+ */
+static inline void openGap(ident *array, unsigned count, unsigned index) {
+	memmove(array + index + 1, array + index, (count - index) * sizeof(ident));
+}
+
+/**
+ * @brief Closes the gap at `index` in the `count` elements of `array`.
+ */
+static inline void closeGap(ident *array, unsigned count, unsigned index) {
+	memmove(array + index, array + index + 1, (count - index - 1) * sizeof(ident));
+}
+
+/**
+ * @brief Inserts `obj` for `key` beneath `node`.
+ * @return If `node` was split, its new right sibling, whose least key is returned in `separator`.
+ */
+static SortedDictionaryNode *insert(SortedDictionary *self, SortedDictionaryNode *node, const ident obj,
+		const ident key, ident *separator) {
+
+	const unsigned half = SORTEDDICTIONARY_ORDER / 2;
+
+	if (node->leaf) {
+
+		SortedDictionaryLeaf *leaf = (SortedDictionaryLeaf *) node, *right = NULL;
+
+		_Bool found;
+		unsigned i = search(self, node, key, &found);
+
+		if (found) {
+			retain(obj);
+			release(leaf->objects[i]);
+
+			leaf->objects[i] = obj;
+			return NULL;
+		}
+
+		if (node->count == SORTEDDICTIONARY_ORDER) {
+
+			right = allocLeaf();
+
+			memcpy(right->node.keys, node->keys + half, half * sizeof(ident));
+			memcpy(right->objects, leaf->objects + half, half * sizeof(ident));
+
+			right->node.count = node->count = half;
+
+			right->prev = leaf;
+			right->next = leaf->next;
+			if (leaf->next) {
+				leaf->next->prev = right;
+			}
+			leaf->next = right;
+
+			if (i > half) {
+				leaf = right;
+				i -= half;
+			}
+		}
+
+		openGap(leaf->node.keys, leaf->node.count, i);
+		openGap(leaf->objects, leaf->node.count, i);
+
+		leaf->node.keys[i] = retain(key);
+		leaf->objects[i] = retain(obj);
+		leaf->node.count++;
+
+		self->mutableDictionary.dictionary.count++;
+
+		if (right) {
+			*separator = retain(right->node.keys[0]);
+		}
+
+		return (SortedDictionaryNode *) right;
+	}
+
+	SortedDictionaryBranch *branch = (SortedDictionaryBranch *) node, *right = NULL;
+	unsigned i = childIndex(self, branch, key);
+
+	ident childSeparator;
+	SortedDictionaryNode *child = insert(self, branch->children[i], obj, key, &childSeparator);
+	if (child == NULL) {
+		return NULL;
+	}
+
+	if (node->count == SORTEDDICTIONARY_ORDER) {
+
+		// the middle separator moves up, and the greater half moves to the new right sibling
+
+		right = allocBranch();
+
+		*separator = node->keys[half];
+
+		memcpy(right->node.keys, node->keys + half + 1, (half - 1) * sizeof(ident));
+		memcpy(right->children, branch->children + half + 1, half * sizeof(SortedDictionaryNode *));
+
+		right->node.count = half - 1;
+		node->count = half;
+
+		if (i > half) {
+			branch = right;
+			i -= half + 1;
+		}
+	}
+
+	openGap(branch->node.keys, branch->node.count, i);
+	openGap((ident *) branch->children, branch->node.count + 1, i + 1);
+
+	branch->node.keys[i] = childSeparator;
+	branch->children[i + 1] = child;
+	branch->node.count++;
+
+	return (SortedDictionaryNode *) right;
+}
+
+/**
+ * @brief Rebalances the leaf at `i` in `branch` with a sibling, if it has fallen below a quarter full.
+ * @details The leaf is merged with its sibling if their pairs fit in one leaf, and otherwise the
+ * pairs are divided evenly between them. Either way, the separator between them is updated.
+ */
+static void rebalanceLeaf(SortedDictionaryBranch *branch, unsigned i) {
+
+	SortedDictionaryNode *node = &branch->node;
+
+	if (node->count == 0 || branch->children[i]->count >= SORTEDDICTIONARY_ORDER / 4) {
+		return;
+	}
+
+	const unsigned s = i < node->count ? i : i - 1;
+
+	SortedDictionaryLeaf *left = (SortedDictionaryLeaf *) branch->children[s];
+	SortedDictionaryLeaf *right = (SortedDictionaryLeaf *) branch->children[s + 1];
+
+	const unsigned total = left->node.count + right->node.count;
+
+	if (total <= SORTEDDICTIONARY_ORDER) {
+
+		memcpy(left->node.keys + left->node.count, right->node.keys, right->node.count * sizeof(ident));
+		memcpy(left->objects + left->node.count, right->objects, right->node.count * sizeof(ident));
+
+		left->node.count = total;
+
+		left->next = right->next;
+		if (right->next) {
+			right->next->prev = left;
+		}
+
+		free(right);
+
+		release(node->keys[s]);
+
+		closeGap(node->keys, node->count, s);
+		closeGap((ident *) branch->children, node->count + 1, s + 1);
+
+		node->count--;
+		return;
+	}
+
+	const unsigned half = total / 2;
+
+	if (left->node.count < half) {
+
+		const unsigned n = half - left->node.count;
+
+		memcpy(left->node.keys + left->node.count, right->node.keys, n * sizeof(ident));
+		memcpy(left->objects + left->node.count, right->objects, n * sizeof(ident));
+
+		memmove(right->node.keys, right->node.keys + n, (right->node.count - n) * sizeof(ident));
+		memmove(right->objects, right->objects + n, (right->node.count - n) * sizeof(ident));
+
+		left->node.count += n;
+		right->node.count -= n;
+	} else {
+
+		const unsigned n = left->node.count - half;
+
+		memmove(right->node.keys + n, right->node.keys, right->node.count * sizeof(ident));
+		memmove(right->objects + n, right->objects, right->node.count * sizeof(ident));
+
+		memcpy(right->node.keys, left->node.keys + half, n * sizeof(ident));
+		memcpy(right->objects, left->objects + half, n * sizeof(ident));
+
+		left->node.count -= n;
+		right->node.count += n;
+	}
+
+	release(node->keys[s]);
+	node->keys[s] = retain(right->node.keys[0]);
+}
+
+/**
+ * @brief Removes the pair for `key` beneath `node`.
+ * @return True if `node` was left empty, and freed.
+ * @remarks Leaves which fall below a quarter full are merged with, or borrow from, a sibling.
+ * Branches are not rebalanced as they shrink. Instead, empty nodes are unlinked from the tree,
+ * which keeps removal simple and its cost bounded by the height of the tree.
+ */
+static _Bool removeKey(SortedDictionary *self, SortedDictionaryNode *node, const ident key) {
+
+	if (node->leaf) {
+
+		SortedDictionaryLeaf *leaf = (SortedDictionaryLeaf *) node;
+
+		_Bool found;
+		const unsigned i = search(self, node, key, &found);
+
+		if (found == false) {
+			return false;
+		}
+
+		release(node->keys[i]);
+		release(leaf->objects[i]);
+
+		closeGap(node->keys, node->count, i);
+		closeGap(leaf->objects, node->count, i);
+
+		node->count--;
+
+		self->mutableDictionary.dictionary.count--;
+
+		if (node->count) {
+			return false;
+		}
+
+		if (leaf->prev) {
+			leaf->prev->next = leaf->next;
+		} else {
+			self->first = leaf->next;
+		}
+
+		if (leaf->next) {
+			leaf->next->prev = leaf->prev;
+		}
+
+		free(leaf);
+		return true;
+	}
+
+	SortedDictionaryBranch *branch = (SortedDictionaryBranch *) node;
+	const unsigned i = childIndex(self, branch, key);
+
+	if (removeKey(self, branch->children[i], key) == false) {
+		if (branch->children[i]->leaf) {
+			rebalanceLeaf(branch, i);
+		}
+		return false;
+	}
+
+	if (node->count == 0) {
+		free(branch);
+		return true;
+	}
+
+	const unsigned separator = i ? i - 1 : 0;
+
+	release(node->keys[separator]);
+
+	closeGap(node->keys, node->count, separator);
+	closeGap((ident *) branch->children, node->count + 1, i);
+
+	node->count--;
+
+	return false;
+}
+
+/**
+ * @brief Replaces the pairs of this SortedDictionary with the given sorted pairs.
+ * @details Leaves are packed full and linked, and then each level of branches is built over the
+ * level beneath it, with the children divided evenly among the branches.
+ */
+static void load(SortedDictionary *self, const ident *objects, const ident *keys, size_t count) {
+
+	assert(self->root == NULL);
+
+	if (count == 0) {
+		return;
+	}
+
+	size_t width = (count + SORTEDDICTIONARY_ORDER - 1) / SORTEDDICTIONARY_ORDER;
+
+	SortedDictionaryNode **nodes = calloc(width, sizeof(SortedDictionaryNode *));
+	ident *least = calloc(width, sizeof(ident));
+
+	assert(nodes);
+	assert(least);
+
+	SortedDictionaryLeaf *prev = NULL;
+
+	for (size_t n = 0, i = 0; n < width; n++) {
+
+		SortedDictionaryLeaf *leaf = allocLeaf();
+
+		const size_t end = (count * (n + 1)) / width;
+
+		for (; i < end; i++) {
+
+			assert(objects[i]);
+			assert(keys[i]);
+			assert(i == 0 || self->comparator(keys[i - 1], keys[i]) == OrderAscending);
+
+			leaf->node.keys[leaf->node.count] = retain(keys[i]);
+			leaf->objects[leaf->node.count] = retain(objects[i]);
+			leaf->node.count++;
+		}
+
+		leaf->prev = prev;
+		if (prev) {
+			prev->next = leaf;
+		} else {
+			self->first = leaf;
+		}
+		prev = leaf;
+
+		nodes[n] = (SortedDictionaryNode *) leaf;
+		least[n] = leaf->node.keys[0];
+	}
+
+	while (width > 1) {
+
+		const size_t parents = (width + SORTEDDICTIONARY_ORDER) / (SORTEDDICTIONARY_ORDER + 1);
+
+		for (size_t n = 0, i = 0; n < parents; n++) {
+
+			SortedDictionaryBranch *branch = allocBranch();
+
+			const size_t begin = i, end = (width * (n + 1)) / parents;
+
+			for (; i < end; i++) {
+				if (i > begin) {
+					branch->node.keys[branch->node.count++] = retain(least[i]);
+				}
+				branch->children[i - begin] = nodes[i];
+			}
+
+			nodes[n] = (SortedDictionaryNode *) branch;
+			least[n] = least[begin];
+		}
+
+		width = parents;
+	}
+
+	self->root = nodes[0];
+	self->mutableDictionary.dictionary.count = count;
+
+	free(nodes);
+	free(least);
+}
+
+/**
+ * @brief Gathers the pairs of `dictionary`, in order, into newly allocated parallel arrays.
+ * @return The number of pairs gathered.
+ */
+static size_t gather(const Dictionary *dictionary, ident **objects, ident **keys) {
+
+	const size_t count = dictionary->count;
+
+	*objects = *keys = NULL;
+
+	if (count) {
+		*objects = malloc(count * 2 * sizeof(ident));
+		assert(*objects);
+
+		*keys = *objects + count;
+
+		DictionaryIterator iterator = $(dictionary, iterator);
+		for (size_t i = 0; i < count; i++) {
+			$(dictionary, nextObjectAndKey, &iterator, *objects + i, *keys + i);
+		}
+	}
+
+	return count;
+}
+
+#pragma mark - Object
+
+/**
+ * @see Object::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+
+	const SortedDictionary *this = (SortedDictionary *) self;
+
+	SortedDictionary *that = $(alloc(SortedDictionary), initWithComparator, this->comparator);
+	if (that) {
+
+		ident *objects, *keys;
+		const size_t count = gather((Dictionary *) self, &objects, &keys);
+
+		load(that, objects, keys, count);
+
+		free(objects);
+	}
+
+	return (Object *) that;
+}
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+	SortedDictionary *this = (SortedDictionary *) self;
+
+	if (this->root) {
+		freeNode(this->root);
+	}
+
+	super(Object, self, dealloc);
+}
+
+#pragma mark - Dictionary
+
+/**
+ * @see Dictionary::enumerateObjectsAndKeys(const Dictionary *, DictionaryEnumerator, ident)
+ */
+static void enumerateObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		ident data) {
+
+	$((SortedDictionary *) self, enumerateObjectsAndKeysInRange, NULL, NULL, enumerator, data);
+}
+
+/**
+ * @see Dictionary::filterObjectsAndKeys(const Dictionary *, DictionaryEnumerator, ident)
+ */
+static Dictionary *filterObjectsAndKeys(const Dictionary *self, DictionaryEnumerator enumerator,
+		ident data) {
+
+	assert(enumerator);
+
+	const SortedDictionary *this = (SortedDictionary *) self;
+
+	ident *objects, *keys;
+	const size_t count = gather(self, &objects, &keys);
+
+	size_t filtered = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		if (enumerator(self, objects[i], keys[i], data)) {
+			objects[filtered] = objects[i];
+			keys[filtered] = keys[i];
+			filtered++;
+		}
+	}
+
+	SortedDictionary *dictionary = $(alloc(SortedDictionary), initWithComparator, this->comparator);
+
+	load(dictionary, objects, keys, filtered);
+
+	free(objects);
+
+	return (Dictionary *) dictionary;
+}
+
+/**
+ * @see Dictionary::initWithDictionary(Dictionary *, const Dictionary *)
+ * @remarks Only a SortedDictionary provides a Comparator, so any other `dictionary` fails.
+ */
+static Dictionary *initWithDictionary(Dictionary *self, const Dictionary *dictionary) {
+
+	if (dictionary == NULL || $((Object *) dictionary, isKindOfClass, _SortedDictionary()) == false) {
+		release(self);
+		return NULL;
+	}
+
+	SortedDictionary *this = $((SortedDictionary *) self, initWithComparator,
+			((SortedDictionary *) dictionary)->comparator);
+	if (this) {
+
+		ident *objects, *keys;
+		const size_t count = gather(dictionary, &objects, &keys);
+
+		load(this, objects, keys, count);
+
+		free(objects);
+	}
+
+	return (Dictionary *) this;
+}
+
+/**
+ * @see Dictionary::initWithObjectsForKeysCount(Dictionary *, const ident *, const ident *, size_t)
+ * @remarks Without a Comparator, this initializer fails.
+ */
+static Dictionary *initWithObjectsForKeysCount(Dictionary *self, const ident *objects, const ident *keys, size_t count) {
+
+	release(self);
+	return NULL;
+}
+
+/**
+ * @see Dictionary::iterator(const Dictionary *)
+ */
+static DictionaryIterator iterator(const Dictionary *self) {
+
+	const SortedDictionary *this = (SortedDictionary *) self;
+
+	DictionaryIterator iterator = {
+		.index = 0
+	};
+
+	iterator.nodes[0] = this->first;
+
+	return iterator;
+}
+
+/**
+ * @see Dictionary::mutableCopy(const Dictionary *)
+ */
+static MutableDictionary *mutableCopy(const Dictionary *self) {
+
+	return (MutableDictionary *) copy((Object *) self);
+}
+
+/**
+ * @see Dictionary::nextObjectAndKey(const Dictionary *, DictionaryIterator *, ident *, ident *)
+ * @remarks The iterator walks the linked leaves, holding the current leaf in its node stack.
+ */
+static _Bool nextObjectAndKey(const Dictionary *self, DictionaryIterator *iterator, ident *obj, ident *key) {
+
+	assert(iterator);
+
+	const SortedDictionaryLeaf *leaf = iterator->nodes[0];
+
+	while (leaf) {
+
+		if (iterator->index < leaf->node.count) {
+
+			if (obj) {
+				*obj = leaf->objects[iterator->index];
+			}
+			if (key) {
+				*key = leaf->node.keys[iterator->index];
+			}
+
+			iterator->index++;
+			return true;
+		}
+
+		leaf = iterator->nodes[0] = leaf->next;
+		iterator->index = 0;
+	}
+
+	return false;
+}
+
+/**
+ * @see Dictionary::objectForKey(const Dictionary *, const ident)
+ */
+static ident objectForKey(const Dictionary *self, const ident key) {
+
+	const SortedDictionary *this = (SortedDictionary *) self;
+
+	unsigned i;
+	_Bool found;
+
+	const SortedDictionaryLeaf *leaf = leafForKey(this, key, &i, &found);
+	if (leaf && found) {
+		return leaf->objects[i];
+	}
+
+	return NULL;
+}
+
+#pragma mark - MutableDictionary
+
+/**
+ * @see MutableDictionary::initWithCapacity(MutableDictionary *, size_t)
+ * @remarks Without a Comparator, this initializer fails.
+ */
+static MutableDictionary *initWithCapacity(MutableDictionary *self, size_t capacity) {
+
+	release(self);
+	return NULL;
+}
+
+/**
+ * @see MutableDictionary::removeAllObjects(MutableDictionary *)
+ */
+static void removeAllObjects(MutableDictionary *self) {
+
+	SortedDictionary *this = (SortedDictionary *) self;
+
+	if (this->root) {
+		freeNode(this->root);
+	}
+
+	this->root = this->first = NULL;
+
+	self->dictionary.count = 0;
+}
+
+/**
+ * @see MutableDictionary::removeObjectForKey(MutableDictionary *, const ident)
+ */
+static void removeObjectForKey(MutableDictionary *self, const ident key) {
+
+	SortedDictionary *this = (SortedDictionary *) self;
+
+	if (this->root == NULL) {
+		return;
+	}
+
+	if (removeKey(this, this->root, key)) {
+		this->root = this->first = NULL;
+		return;
+	}
+
+	SortedDictionaryNode *root = this->root;
+	while (root->leaf == false && root->count == 0) {
+		this->root = ((SortedDictionaryBranch *) root)->children[0];
+		free(root);
+		root = this->root;
+	}
+}
+
+/**
+ * @see MutableDictionary::setObjectForKey(MutableDictionary *, const ident, const ident)
+ */
+static void setObjectForKey(MutableDictionary *self, const ident obj, const ident key) {
+
+	assert(obj);
+	assert(key);
+
+	SortedDictionary *this = (SortedDictionary *) self;
+
+	assert(this->comparator);
+
+	if (this->root == NULL) {
+		this->root = this->first = allocLeaf();
+	}
+
+	ident separator;
+	SortedDictionaryNode *right = insert(this, this->root, obj, key, &separator);
+
+	if (right) {
+
+		SortedDictionaryBranch *root = allocBranch();
+
+		root->node.keys[0] = separator;
+		root->node.count = 1;
+
+		root->children[0] = this->root;
+		root->children[1] = right;
+
+		this->root = root;
+	}
+}
+
+#pragma mark - SortedDictionary
+
+/**
+ * @fn ident SortedDictionary::ceilingKey(const SortedDictionary *self, const ident key)
+ * @memberof SortedDictionary
+ */
+static ident ceilingKey(const SortedDictionary *self, const ident key) {
+
+	unsigned i;
+	_Bool found;
+
+	const SortedDictionaryLeaf *leaf = leafForKey(self, key, &i, &found);
+	if (leaf == NULL) {
+		return NULL;
+	}
+
+	if (i < leaf->node.count) {
+		return leaf->node.keys[i];
+	}
+
+	return leaf->next ? leaf->next->node.keys[0] : NULL;
+}
+
+/**
+ * @fn SortedDictionary *SortedDictionary::dictionaryWithComparator(Comparator comparator)
+ * @memberof SortedDictionary
+ */
+static SortedDictionary *dictionaryWithComparator(Comparator comparator) {
+
+	return $(alloc(SortedDictionary), initWithComparator, comparator);
+}
+
+/**
+ * @fn void SortedDictionary::enumerateObjectsAndKeysInRange(const SortedDictionary *self, const ident from, const ident to, DictionaryEnumerator enumerator, ident data)
+ * @memberof SortedDictionary
+ */
+static void enumerateObjectsAndKeysInRange(const SortedDictionary *self, const ident from, const ident to,
+		DictionaryEnumerator enumerator, ident data) {
+
+	assert(enumerator);
+
+	const SortedDictionaryLeaf *leaf = self->first;
+	unsigned i = 0;
+
+	if (from) {
+		_Bool found;
+		leaf = leafForKey(self, from, &i, &found);
+	}
+
+	for (; leaf; leaf = leaf->next, i = 0) {
+		for (; i < leaf->node.count; i++) {
+
+			const ident key = leaf->node.keys[i];
+
+			if (to && self->comparator(key, to) != OrderAscending) {
+				return;
+			}
+
+			if (enumerator((Dictionary *) self, leaf->objects[i], key, data)) {
+				return;
+			}
+		}
+	}
+}
+
+/**
+ * @fn ident SortedDictionary::floorKey(const SortedDictionary *self, const ident key)
+ * @memberof SortedDictionary
+ */
+static ident floorKey(const SortedDictionary *self, const ident key) {
+
+	unsigned i;
+	_Bool found;
+
+	const SortedDictionaryLeaf *leaf = leafForKey(self, key, &i, &found);
+	if (leaf == NULL) {
+		return NULL;
+	}
+
+	if (found) {
+		return leaf->node.keys[i];
+	}
+
+	if (i > 0) {
+		return leaf->node.keys[i - 1];
+	}
+
+	return leaf->prev ? leaf->prev->node.keys[leaf->prev->node.count - 1] : NULL;
+}
+
+/**
+ * @fn SortedDictionary *SortedDictionary::initWithComparator(SortedDictionary *self, Comparator comparator)
+ * @memberof SortedDictionary
+ */
+static SortedDictionary *initWithComparator(SortedDictionary *self, Comparator comparator) {
+
+	if (comparator == NULL) {
+		release(self);
+		return NULL;
+	}
+
+	self = (SortedDictionary *) super(Object, self, init);
+	if (self) {
+		self->comparator = comparator;
+	}
+
+	return self;
+}
+
+/**
+ * @fn SortedDictionary *SortedDictionary::initWithSortedObjectsForKeys(SortedDictionary *self, Comparator comparator, const Array *objects, const Array *keys)
+ * @memberof SortedDictionary
+ */
+static SortedDictionary *initWithSortedObjectsForKeys(SortedDictionary *self, Comparator comparator,
+		const Array *objects, const Array *keys) {
+
+	assert(comparator);
+	assert(objects);
+	assert(keys);
+	assert(objects->count == keys->count);
+
+	self = $(self, initWithComparator, comparator);
+	if (self) {
+		load(self, objects->elements, keys->elements, keys->count);
+	}
+
+	return self;
+}
+
+/**
+ * @brief A DictionaryEnumerator for objectsInRange.
+ */
+static _Bool objectsInRange_enumerator(const Dictionary *dict, ident obj, ident key, ident data) {
+	$((MutableArray *) data, addObject, obj); return false;
+}
+
+/**
+ * @fn Array *SortedDictionary::objectsInRange(const SortedDictionary *self, const ident from, const ident to)
+ * @memberof SortedDictionary
+ */
+static Array *objectsInRange(const SortedDictionary *self, const ident from, const ident to) {
+
+	MutableArray *objects = $(alloc(MutableArray), init);
+
+	$(self, enumerateObjectsAndKeysInRange, from, to, objectsInRange_enumerator, objects);
+
+	return (Array *) objects;
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+	ObjectInterface *object = (ObjectInterface *) clazz->def->interface;
+
+	object->copy = copy;
+	object->dealloc = dealloc;
+
+	DictionaryInterface *dictionary = (DictionaryInterface *) clazz->def->interface;
+
+	dictionary->enumerateObjectsAndKeys = enumerateObjectsAndKeys;
+	dictionary->filterObjectsAndKeys = filterObjectsAndKeys;
+	dictionary->initWithDictionary = initWithDictionary;
+	dictionary->initWithObjectsForKeysCount = initWithObjectsForKeysCount;
+	dictionary->iterator = iterator;
+	dictionary->mutableCopy = mutableCopy;
+	dictionary->nextObjectAndKey = nextObjectAndKey;
+	dictionary->objectForKey = objectForKey;
+
+	MutableDictionaryInterface *mutableDictionary = (MutableDictionaryInterface *) clazz->def->interface;
+
+	mutableDictionary->initWithCapacity = initWithCapacity;
+	mutableDictionary->removeAllObjects = removeAllObjects;
+	mutableDictionary->removeObjectForKey = removeObjectForKey;
+	mutableDictionary->setObjectForKey = setObjectForKey;
+
+	SortedDictionaryInterface *sortedDictionary = (SortedDictionaryInterface *) clazz->def->interface;
+
+	sortedDictionary->ceilingKey = ceilingKey;
+	sortedDictionary->dictionaryWithComparator = dictionaryWithComparator;
+	sortedDictionary->enumerateObjectsAndKeysInRange = enumerateObjectsAndKeysInRange;
+	sortedDictionary->floorKey = floorKey;
+	sortedDictionary->initWithComparator = initWithComparator;
+	sortedDictionary->initWithSortedObjectsForKeys = initWithSortedObjectsForKeys;
+	sortedDictionary->objectsInRange = objectsInRange;
+}
+
+/**
+ * @fn Class *SortedDictionary::_SortedDictionary(void)
+ * @memberof SortedDictionary
+ */
+Class *_SortedDictionary(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "SortedDictionary";
+		clazz.superclass = _MutableDictionary();
+		clazz.instanceSize = sizeof(SortedDictionary);
+		clazz.interfaceOffset = offsetof(SortedDictionary, interface);
+		clazz.interfaceSize = sizeof(SortedDictionaryInterface);
+		clazz.initialize = initialize;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
@@ -0,0 +1,174 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <Objectively/Array.h>
+#include <Objectively/MutableDictionary.h>
+
+/**
+ * @file
+ * @brief Mutable key-value stores, which keep their keys in order.
+ */
+
+typedef struct SortedDictionary SortedDictionary;
+typedef struct SortedDictionaryInterface SortedDictionaryInterface;
+
+/**
+ * @brief Mutable key-value stores, which keep their keys in order.
+ * @details SortedDictionary stores its pairs in a B+ tree, ordered by a Comparator. Keys are
+ * searched in small contiguous arrays, and the leaves of the tree are linked, so that ordered
+ * enumeration, range queries and floor and ceiling lookups need not sort or hash.
+ * @remarks A SortedDictionary requires a Comparator. Of the initializers inherited from Dictionary
+ * and MutableDictionary, only `initWithDictionary` with a SortedDictionary succeeds, adopting its
+ * Comparator. The others release the instance and return `NULL`.
+ * @extends MutableDictionary
+ * @ingroup Collections
+ */
+struct SortedDictionary {
+
+	/**
+	 * @brief The superclass.
+	 */
+	MutableDictionary mutableDictionary;
+
+	/**
+	 * @brief The interface.
+	 * @protected
+	 */
+	SortedDictionaryInterface *interface;
+
+	/**
+	 * @brief The Comparator by which keys are ordered.
+	 */
+	Comparator comparator;
+
+	/**
+	 * @brief The root node of the tree, or `NULL` if this SortedDictionary is empty.
+	 * @private
+	 */
+	ident root;
+
+	/**
+	 * @brief The first (least) leaf of the tree.
+	 * @private
+	 */
+	ident first;
+};
+
+/**
+ * @brief The SortedDictionary interface.
+ */
+struct SortedDictionaryInterface {
+
+	/**
+	 * @brief The superclass.
+	 */
+	MutableDictionaryInterface mutableDictionaryInterface;
+
+	/**
+	 * @fn ident SortedDictionary::ceilingKey(const SortedDictionary *self, const ident key)
+	 * @param self The SortedDictionary.
+	 * @param key The key.
+	 * @return The least key in this SortedDictionary which is greater than or equal to `key`,
+	 * or `NULL` if there is none.
+	 * @memberof SortedDictionary
+	 */
+	ident (*ceilingKey)(const SortedDictionary *self, const ident key);
+
+	/**
+	 * @static
+	 * @fn SortedDictionary *SortedDictionary::dictionaryWithComparator(Comparator comparator)
+	 * @brief Returns a new SortedDictionary ordered by `comparator`.
+	 * @param comparator The Comparator.
+	 * @return The new SortedDictionary, or `NULL` on error.
+	 * @memberof SortedDictionary
+	 */
+	SortedDictionary *(*dictionaryWithComparator)(Comparator comparator);
+
+	/**
+	 * @fn void SortedDictionary::enumerateObjectsAndKeysInRange(const SortedDictionary *self, const ident from, const ident to, DictionaryEnumerator enumerator, ident data)
+	 * @brief Enumerates, in order, the pairs of this SortedDictionary whose keys are within the given range.
+	 * @param self The SortedDictionary.
+	 * @param from The least key to enumerate, inclusive, or `NULL` to begin with the first key.
+	 * @param to The greatest key to enumerate, exclusive, or `NULL` to end with the last key.
+	 * @param enumerator The enumerator function.
+	 * @param data User data.
+	 * @remarks The enumerator should return `true` to break the iteration.
+	 * @memberof SortedDictionary
+	 */
+	void (*enumerateObjectsAndKeysInRange)(const SortedDictionary *self, const ident from, const ident to,
+			DictionaryEnumerator enumerator, ident data);
+
+	/**
+	 * @fn ident SortedDictionary::floorKey(const SortedDictionary *self, const ident key)
+	 * @param self The SortedDictionary.
+	 * @param key The key.
+	 * @return The greatest key in this SortedDictionary which is less than or equal to `key`,
+	 * or `NULL` if there is none.
+	 * @memberof SortedDictionary
+	 */
+	ident (*floorKey)(const SortedDictionary *self, const ident key);
+
+	/**
+	 * @fn SortedDictionary *SortedDictionary::initWithComparator(SortedDictionary *self, Comparator comparator)
+	 * @brief Initializes this SortedDictionary, ordered by `comparator`.
+	 * @param self The SortedDictionary.
+	 * @param comparator The Comparator.
+	 * @return The initialized SortedDictionary, or `NULL` on error or if `comparator` is `NULL`.
+	 * @memberof SortedDictionary
+	 */
+	SortedDictionary *(*initWithComparator)(SortedDictionary *self, Comparator comparator);
+
+	/**
+	 * @fn SortedDictionary *SortedDictionary::initWithSortedObjectsForKeys(SortedDictionary *self, Comparator comparator, const Array *objects, const Array *keys)
+	 * @brief Initializes this SortedDictionary with the pairs of the given parallel Arrays.
+	 * @param self The SortedDictionary.
+	 * @param comparator The Comparator.
+	 * @param objects The Objects.
+	 * @param keys The keys, which must be distinct and in ascending order by `comparator`.
+	 * @return The initialized SortedDictionary, or `NULL` on error.
+	 * @details The tree is built bottom up, in linear time, with every leaf packed full.
+	 * @memberof SortedDictionary
+	 */
+	SortedDictionary *(*initWithSortedObjectsForKeys)(SortedDictionary *self, Comparator comparator,
+			const Array *objects, const Array *keys);
+
+	/**
+	 * @fn Array *SortedDictionary::objectsInRange(const SortedDictionary *self, const ident from, const ident to)
+	 * @param self The SortedDictionary.
+	 * @param from The least key, inclusive, or `NULL` to begin with the first key.
+	 * @param to The greatest key, exclusive, or `NULL` to end with the last key.
+	 * @return The Objects whose keys are within the given range, in key order.
+	 * @memberof SortedDictionary
+	 */
+	Array *(*objectsInRange)(const SortedDictionary *self, const ident from, const ident to);
+};
+
+/**
+ * @fn Class *SortedDictionary::_SortedDictionary(void)
+ * @brief The SortedDictionary archetype.
+ * @return The SortedDictionary Class.
+ * @memberof SortedDictionary
+ */
+OBJECTIVELY_EXPORT Class *_SortedDictionary(void);
@@ -81,7 +81,12 @@ static int hash(const Object *self) {
 
 	String *this = (String *) self;
 
-	return HashForCString(HASH_SEED, this->chars);
+	if (this->hash == 0) {
+		const Range range = { 0, this->length };
+		this->hash = HashForCharacters(HASH_SEED, this->chars, range);
+	}
+
+	return this->hash;
 }
 
 /**
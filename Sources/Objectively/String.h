@@ -87,6 +87,12 @@ struct String {
 	 * @brief The length of the String in bytes.
 	 */
 	size_t length;
+
+	/**
+	 * @brief The hash, computed lazily, or `0` if it has not yet been computed.
+	 * @private
+	 */
+	int hash;
 };
 
 typedef struct MutableString MutableString;
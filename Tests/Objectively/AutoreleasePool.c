@@ -0,0 +1,116 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <check.h>
+
+#include <Objectively.h>
+
+START_TEST(autoreleasePool)
+	{
+		ck_assert_ptr_eq(NULL, $$(AutoreleasePool, currentPool));
+
+		AutoreleasePool *pool = $(alloc(AutoreleasePool), init);
+		ck_assert(pool != NULL);
+		ck_assert_ptr_eq(pool, $$(AutoreleasePool, currentPool));
+
+		Object *object = $(alloc(Object), init);
+		String *string = str("hello");
+
+		ck_assert_ptr_eq(object, autorelease(retain(object)));
+		ck_assert_ptr_eq(string, autorelease(retain(string)));
+		ck_assert_ptr_eq(NULL, autorelease(NULL));
+
+		ck_assert_int_eq(2, pool->count);
+		ck_assert_int_eq(2, object->referenceCount);
+
+		$(pool, drain);
+
+		ck_assert_int_eq(0, pool->count);
+		ck_assert_int_eq(1, object->referenceCount);
+		ck_assert_int_eq(1, ((Object *) string)->referenceCount);
+
+		AutoreleasePool *inner = $(alloc(AutoreleasePool), init);
+		ck_assert_ptr_eq(inner, $$(AutoreleasePool, currentPool));
+
+		autorelease(retain(object));
+		ck_assert_int_eq(0, pool->count);
+		ck_assert_int_eq(1, inner->count);
+
+		release(inner);
+
+		ck_assert_ptr_eq(pool, $$(AutoreleasePool, currentPool));
+		ck_assert_int_eq(1, object->referenceCount);
+
+		autorelease(object);
+		autorelease(string);
+
+		release(pool);
+
+		ck_assert_ptr_eq(NULL, $$(AutoreleasePool, currentPool));
+
+		Object *orphan = $(alloc(Object), init);
+
+		ck_assert_ptr_eq(orphan, autorelease(retain(orphan)));
+		ck_assert_int_eq(2, orphan->referenceCount);
+
+		release(orphan);
+		release(orphan);
+
+	}END_TEST
+
+START_TEST(withAutoreleasePool)
+	{
+		Object *object = $(alloc(Object), init);
+
+		WithAutoreleasePool({
+			for (int i = 0; i < 1000; i++) {
+				autorelease(retain(object));
+			}
+			ck_assert_int_eq(1001, object->referenceCount);
+		});
+
+		ck_assert_int_eq(1, object->referenceCount);
+
+		release(object);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("autoreleasePool");
+	tcase_add_test(tcase, autoreleasePool);
+	tcase_add_test(tcase, withAutoreleasePool);
+
+	Suite *suite = suite_create("autoreleasePool");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
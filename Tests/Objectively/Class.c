@@ -0,0 +1,445 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <check.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <Objectively.h>
+
+#define _Class _Counted
+
+static Class *_Counted(void);
+
+static int deallocations;
+
+static void countDeallocation(Object *self) {
+
+	__sync_add_and_fetch(&deallocations, 1);
+
+	super(Object, self, dealloc);
+}
+
+static void initializeCounted(Class *clazz) {
+	((ObjectInterface *) clazz->def->interface)->dealloc = countDeallocation;
+}
+
+/**
+ * @brief A Class whose deallocations are counted.
+ */
+static Class *_Counted(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "Counted";
+		clazz.superclass = _Object();
+		clazz.instanceSize = sizeof(Object);
+		clazz.interfaceOffset = offsetof(Object, interface);
+		clazz.interfaceSize = sizeof(ObjectInterface);
+		clazz.initialize = initializeCounted;
+	});
+
+	return &clazz;
+}
+
+/**
+ * @brief A Class whose allocations are tallied.
+ */
+static Class *_Tallied(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "Tallied";
+		clazz.superclass = _Object();
+		clazz.instanceSize = sizeof(Object);
+		clazz.interfaceOffset = offsetof(Object, interface);
+		clazz.interfaceSize = sizeof(ObjectInterface);
+	});
+
+	return &clazz;
+}
+
+static int initializations;
+
+/**
+ * @brief A slow Class initializer, which widens the window in which threads race.
+ */
+static void initializeSlowly(Class *clazz) {
+
+	usleep(10000);
+
+	__sync_add_and_fetch(&initializations, 1);
+}
+
+#define SLOW_CLASS(type, super) \
+	static Class *_##type(void) { \
+		static Class clazz; \
+		static Once once; \
+		do_once(&once, { \
+			clazz.name = #type; \
+			clazz.superclass = super; \
+			clazz.instanceSize = sizeof(Object); \
+			clazz.interfaceOffset = offsetof(Object, interface); \
+			clazz.interfaceSize = sizeof(ObjectInterface); \
+			clazz.initialize = initializeSlowly; \
+			usleep(1000); \
+		}); \
+		return &clazz; \
+	}
+
+SLOW_CLASS(SlowBase, _Object())
+SLOW_CLASS(SlowMiddle, _SlowBase())
+SLOW_CLASS(SlowLeaf, _SlowMiddle())
+
+static pthread_rwlock_t start = PTHREAD_RWLOCK_INITIALIZER;
+
+static ident allocSlowly(ident data) {
+
+	pthread_rwlock_rdlock(&start);
+	pthread_rwlock_unlock(&start);
+
+	Object *object = _alloc(((Class *(*)(void)) data)());
+
+	const _Bool valid = object && object->interface && object->clazz->magic == CLASS_MAGIC;
+
+	release(object);
+
+	return (ident) (intptr_t) valid;
+}
+
+static ident loadWeakly(ident location) {
+
+	size_t loads = 0;
+
+	while (true) {
+		Object *object = loadWeak((ident *) location);
+		if (object == NULL) {
+			break;
+		}
+
+		ck_assert_ptr_eq(_Counted(), object->clazz);
+		release(object);
+		loads++;
+	}
+
+	return (ident) loads;
+}
+
+static ident releaseObject(ident obj) {
+
+	release(obj);
+	return NULL;
+}
+
+static ident allocObject(ident data) {
+
+	return _alloc(_Counted());
+}
+
+static _Bool countClasses(const Class *clazz, ident data) {
+
+	(*(int *) data)++; return false;
+}
+
+static _Bool findClass(const Class *clazz, ident data) {
+
+	const Class **found = (const Class **) data;
+
+	if (clazz == found[0]) {
+		found[1] = clazz;
+		return true;
+	}
+
+	return false;
+}
+
+START_TEST(registry)
+	{
+		ck_assert_ptr_eq(NULL, classForName("MutableArray"));
+
+		MutableArray *array = $(alloc(MutableArray), init);
+		MutableString *string = $(alloc(MutableString), init);
+
+		ck_assert_ptr_eq(&_Object()->def->descriptor, classForName("Object"));
+		ck_assert_ptr_eq(&_Array()->def->descriptor, classForName("Array"));
+		ck_assert_ptr_eq(&_MutableArray()->def->descriptor, classForName("MutableArray"));
+		ck_assert_ptr_eq(&_String()->def->descriptor, classForName("String"));
+		ck_assert_ptr_eq(&_MutableString()->def->descriptor, classForName("MutableString"));
+
+		ck_assert_ptr_eq(NULL, classForName("Dictionary"));
+		ck_assert_ptr_eq(NULL, classForName(NULL));
+
+		release(array);
+		release(string);
+
+	}END_TEST
+
+START_TEST(enumeration)
+	{
+		Array *array = $(alloc(Array), initWithObjects, NULL);
+		MutableArray *mutableArray = $(alloc(MutableArray), init);
+
+		int count = 0;
+		enumerateClasses(countClasses, &count);
+		ck_assert_int_ge(count, 3);
+
+		count = 0;
+		enumerateSubclasses(_Array(), countClasses, &count);
+		ck_assert_int_eq(1, count);
+
+		const Class *found[] = { classForName("MutableArray"), NULL };
+		enumerateSubclasses(_Array(), findClass, found);
+		ck_assert_ptr_eq(found[0], found[1]);
+
+		found[0] = classForName("Array");
+		found[1] = NULL;
+		enumerateSubclasses(_Array(), findClass, found);
+		ck_assert_ptr_eq(NULL, found[1]);
+
+		enumerateSubclasses(_Object(), findClass, found);
+		ck_assert_ptr_eq(found[0], found[1]);
+
+		release(array);
+		release(mutableArray);
+
+	}END_TEST
+
+START_TEST(subclass)
+	{
+		MutableArray *array = $(alloc(MutableArray), init);
+
+		ck_assert(isSubclassOfClass(_MutableArray(), _MutableArray()));
+		ck_assert(isSubclassOfClass(_MutableArray(), _Array()));
+		ck_assert(isSubclassOfClass(_MutableArray(), _Object()));
+		ck_assert(isSubclassOfClass(_MutableArray(), classForName("Array")));
+
+		ck_assert(!isSubclassOfClass(_Array(), _MutableArray()));
+		ck_assert(!isSubclassOfClass(_Object(), _Array()));
+		ck_assert(!isSubclassOfClass(_MutableArray(), _Dictionary()));
+
+		ck_assert($((Object *) array, isKindOfClass, _Array()));
+		ck_assert(!$((Object *) array, isKindOfClass, _String()));
+
+		ck_assert_ptr_eq(array, cast(Array, array));
+
+		release(array);
+
+	}END_TEST
+
+START_TEST(referenceCount)
+	{
+		pthread_t thread;
+		ident result;
+
+		deallocations = 0;
+
+		Object *object = _alloc(_Counted());
+		ck_assert_int_eq(1, object->referenceCount);
+
+		retain(retain(object));
+		ck_assert_int_eq(3, object->referenceCount);
+		ck_assert_int_eq(0, object->sharedReferenceCount);
+
+		release(object);
+		ck_assert_int_eq(2, object->referenceCount);
+
+		pthread_create(&thread, NULL, releaseObject, object);
+		pthread_join(thread, NULL);
+
+		ck_assert_int_eq(2, object->referenceCount);
+		ck_assert_int_lt(object->sharedReferenceCount, 0);
+
+		retain(object);
+		release(object);
+
+		ck_assert_ptr_eq(NULL, object->owner);
+		ck_assert_int_eq(0, object->referenceCount);
+		ck_assert_int_eq(0, deallocations);
+
+		release(object);
+		ck_assert_int_eq(1, deallocations);
+
+		pthread_create(&thread, NULL, allocObject, NULL);
+		pthread_join(thread, &result);
+
+		ck_assert(result != NULL);
+
+		retain(result);
+		release(result);
+		ck_assert_int_eq(1, deallocations);
+
+		release(result);
+		ck_assert_int_eq(2, deallocations);
+
+	}END_TEST
+
+START_TEST(statistics)
+	{
+		ClassStatistics statistics;
+
+		if (getenv("OBJECTIVELY_STATISTICS") == NULL) {
+			_classStatistics = false;
+			ck_assert(!statisticsForClass(_Counted(), &statistics));
+		}
+
+		_classStatistics = true;
+
+		Object *objects[10];
+		for (size_t i = 0; i < lengthof(objects); i++) {
+			objects[i] = _alloc(_Tallied());
+		}
+
+		ck_assert(statisticsForClass(_Tallied(), &statistics));
+		ck_assert_ptr_eq(&_Tallied()->def->descriptor, statistics.clazz);
+		ck_assert_int_eq(10, statistics.allocations);
+		ck_assert_int_eq(10, statistics.live);
+
+		for (size_t i = 0; i < 4; i++) {
+			release(objects[i]);
+		}
+
+		ck_assert(statisticsForClass(_Tallied(), &statistics));
+		ck_assert_int_eq(10, statistics.allocations);
+		ck_assert_int_eq(4, statistics.deallocations);
+		ck_assert_int_eq(6, statistics.live);
+		ck_assert_int_eq(10, statistics.peak);
+		ck_assert_int_eq(6 * sizeof(Object), statistics.bytes);
+
+		FILE *file = tmpfile();
+		dumpClassStatistics(fileno(file));
+
+		char line[256];
+		rewind(file);
+		ck_assert(fgets(line, sizeof(line), file));
+		ck_assert(strstr(line, "Tallied: allocations 10, live 6, peak 10, bytes ") == line);
+		fclose(file);
+
+		for (size_t i = 4; i < lengthof(objects); i++) {
+			release(objects[i]);
+		}
+
+		_classStatistics = false;
+
+	}END_TEST
+
+START_TEST(initialization)
+	{
+		Class *(*classes[])(void) = { _SlowBase, _SlowMiddle, _SlowLeaf };
+		pthread_t threads[384];
+
+		pthread_rwlock_wrlock(&start);
+
+		for (size_t i = 0; i < lengthof(threads); i++) {
+			const int err = pthread_create(&threads[i], NULL, allocSlowly, classes[i % lengthof(classes)]);
+			ck_assert_int_eq(0, err);
+		}
+
+		pthread_rwlock_unlock(&start);
+
+		for (size_t i = 0; i < lengthof(threads); i++) {
+			ident valid;
+			pthread_join(threads[i], &valid);
+			ck_assert(valid);
+		}
+
+		ck_assert_int_eq(3, initializations);
+
+		ck_assert(isSubclassOfClass(_SlowLeaf(), _SlowBase()));
+
+	}END_TEST
+
+START_TEST(weak)
+	{
+		deallocations = 0;
+
+		Object *object = _alloc(_Counted());
+		ident location = NULL, other = NULL;
+
+		storeWeak(&location, object);
+		storeWeak(&other, object);
+		ck_assert_ptr_eq(object, location);
+
+		Object *loaded = loadWeak(&location);
+		ck_assert_ptr_eq(object, loaded);
+		ck_assert_int_eq(2, object->referenceCount);
+		release(loaded);
+
+		storeWeak(&other, NULL);
+		ck_assert_ptr_eq(NULL, other);
+
+		release(object);
+		ck_assert_int_eq(1, deallocations);
+
+		ck_assert_ptr_eq(NULL, location);
+		ck_assert_ptr_eq(NULL, loadWeak(&location));
+
+		storeWeak(&location, $$(Boole, True));
+		ck_assert_ptr_eq($$(Boole, True), loadWeak(&location));
+		storeWeak(&location, NULL);
+
+		object = _alloc(_Counted());
+		storeWeak(&location, object);
+
+		pthread_t threads[4];
+		for (size_t i = 0; i < lengthof(threads); i++) {
+			pthread_create(&threads[i], NULL, loadWeakly, &location);
+		}
+
+		usleep(10000);
+		release(object);
+
+		for (size_t i = 0; i < lengthof(threads); i++) {
+			pthread_join(threads[i], NULL);
+		}
+
+		ck_assert_int_eq(2, deallocations);
+		ck_assert_ptr_eq(NULL, location);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("class");
+	tcase_add_test(tcase, registry);
+	tcase_add_test(tcase, enumeration);
+	tcase_add_test(tcase, subclass);
+	tcase_add_test(tcase, referenceCount);
+	tcase_add_test(tcase, statistics);
+	tcase_add_test(tcase, initialization);
+	tcase_add_test(tcase, weak);
+
+	Suite *suite = suite_create("class");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
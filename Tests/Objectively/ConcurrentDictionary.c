@@ -0,0 +1,178 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <pthread.h>
+
+#include <Objectively.h>
+
+#define THREADS 8
+#define INCREMENTS 10000
+#define KEYS 16
+
+static ConcurrentDictionary *counters;
+
+/**
+ * @brief A ConcurrentDictionaryFunction which increments a Number.
+ */
+static ident increment(const ident key, ident obj, ident data) {
+
+	const int value = obj ? $((Number *) obj, intValue) : 0;
+
+	return $(alloc(Number), initWithValue, value + 1);
+}
+
+/**
+ * @brief A ConcurrentDictionaryFunction which removes its pair.
+ */
+static ident removal(const ident key, ident obj, ident data) {
+	return NULL;
+}
+
+static ident incrementThread(ident data) {
+
+	for (int i = 0; i < INCREMENTS; i++) {
+
+		Number *key = $$(Number, numberWithValue, i % KEYS);
+
+		release($(counters, computeObjectForKey, key, increment, NULL));
+
+		release(key);
+	}
+
+	return NULL;
+}
+
+START_TEST(concurrentDictionary)
+	{
+		ConcurrentDictionary *dict = $(alloc(ConcurrentDictionary), init);
+
+		ck_assert(dict != NULL);
+		ck_assert_ptr_eq(_ConcurrentDictionary(), classof(dict));
+
+		Object *objectOne = $(alloc(Object), init);
+		Object *objectTwo = $(alloc(Object), init);
+
+		String *key = str("key");
+
+		ck_assert_ptr_eq(NULL, $(dict, objectForKey, key));
+
+		$(dict, setObjectForKey, objectOne, key);
+
+		ck_assert_int_eq(1, $(dict, count));
+		ck_assert_int_eq(2, objectOne->referenceCount);
+
+		Object *obj = $(dict, objectForKey, key);
+
+		ck_assert_ptr_eq(objectOne, obj);
+		ck_assert_int_eq(3, objectOne->referenceCount);
+
+		release(obj);
+
+		obj = $(dict, setObjectForKeyIfAbsent, objectTwo, key);
+
+		ck_assert_ptr_eq(objectOne, obj);
+		ck_assert_int_eq(1, objectTwo->referenceCount);
+
+		release(obj);
+
+		Dictionary *snapshot = $(dict, dictionary);
+
+		ck_assert_int_eq(1, snapshot->count);
+		ck_assert_ptr_eq(objectOne, $(snapshot, objectForKey, key));
+
+		release(snapshot);
+
+		obj = $(dict, computeObjectForKey, key, removal, NULL);
+
+		ck_assert_ptr_eq(NULL, obj);
+		ck_assert_int_eq(0, $(dict, count));
+		ck_assert_int_eq(1, objectOne->referenceCount);
+
+		obj = $(dict, setObjectForKeyIfAbsent, objectTwo, key);
+
+		ck_assert_ptr_eq(objectTwo, obj);
+		ck_assert_int_eq(3, objectTwo->referenceCount);
+
+		release(obj);
+
+		$(dict, removeObjectForKey, key);
+
+		ck_assert_int_eq(0, $(dict, count));
+		ck_assert_int_eq(1, objectTwo->referenceCount);
+
+		release(objectOne);
+		release(objectTwo);
+		release(key);
+		release(dict);
+
+		counters = $(alloc(ConcurrentDictionary), init);
+
+		pthread_t threads[THREADS];
+
+		for (int i = 0; i < THREADS; i++) {
+			pthread_create(&threads[i], NULL, incrementThread, NULL);
+		}
+
+		for (int i = 0; i < THREADS; i++) {
+			pthread_join(threads[i], NULL);
+		}
+
+		ck_assert_int_eq(KEYS, $(counters, count));
+
+		for (int i = 0; i < KEYS; i++) {
+
+			Number *key = $$(Number, numberWithValue, i);
+			Number *counter = $(counters, objectForKey, key);
+
+			ck_assert_int_eq(THREADS * INCREMENTS / KEYS, $(counter, intValue));
+
+			release(counter);
+			release(key);
+		}
+
+		$(counters, removeAllObjects);
+
+		ck_assert_int_eq(0, $(counters, count));
+
+		release(counters);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("concurrentDictionary");
+	tcase_add_test(tcase, concurrentDictionary);
+
+	Suite *suite = suite_create("concurrentDictionary");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
@@ -75,6 +75,19 @@ START_TEST(dictionary)
 
 		ck_assert_int_eq(dict->count, counter);
 
+		DictionaryIterator iterator = $(dict, iterator);
+		ident obj, key;
+
+		counter = 0;
+
+		while ($(dict, nextObjectAndKey, &iterator, &obj, &key)) {
+			ck_assert_ptr_eq(obj, $(dict, objectForKey, key));
+			counter++;
+		}
+
+		ck_assert_int_eq(dict->count, counter);
+		ck_assert(!$(dict, nextObjectAndKey, &iterator, &obj, &key));
+
 		Dictionary *filtered = $(dict, filterObjectsAndKeys, filter, NULL);
 
 		ck_assert_int_eq(1, filtered->count);
@@ -85,10 +98,80 @@ START_TEST(dictionary)
 
 	}END_TEST
 
+START_TEST(objectsForKeys)
+	{
+		Object *objectOne = $(alloc(Object), init);
+		Object *objectTwo = $(alloc(Object), init);
+		Object *objectThree = $(alloc(Object), init);
+
+		String *keyOne = str("one");
+		String *keyTwo = str("two");
+
+		Array *objects = $$(Array, arrayWithObjects, objectOne, objectTwo, objectThree, NULL);
+		Array *keys = $$(Array, arrayWithObjects, keyOne, keyTwo, keyOne, NULL);
+
+		Dictionary *dict = $$(Dictionary, dictionaryWithObjectsForKeys, objects, keys);
+
+		ck_assert_ptr_eq(_Dictionary(), classof(dict));
+		ck_assert_int_eq(2, dict->count);
+
+		ck_assert_ptr_eq(objectThree, $(dict, objectForKey, keyOne));
+		ck_assert_ptr_eq(objectTwo, $(dict, objectForKey, keyTwo));
+
+		ck_assert_int_eq(2, objectOne->referenceCount);
+		ck_assert_int_eq(3, objectTwo->referenceCount);
+		ck_assert_int_eq(3, objectThree->referenceCount);
+
+		release(dict);
+
+		const ident objs[] = { objectOne, objectTwo };
+		const ident ks[] = { keyOne, keyTwo };
+
+		Class *classes[] = {
+			_Dictionary(), _MutableDictionary(), _OrderedDictionary(), _FrozenDictionary(), _PersistentDictionary()
+		};
+
+		for (size_t i = 0; i < lengthof(classes); i++) {
+
+			dict = $((Dictionary *) _alloc(classes[i]), initWithObjectsForKeysCount, objs, ks, 2);
+
+			ck_assert_ptr_eq(classes[i], classof(dict));
+			ck_assert_int_eq(2, dict->count);
+
+			ck_assert_ptr_eq(objectOne, $(dict, objectForKey, keyOne));
+			ck_assert_ptr_eq(objectTwo, $(dict, objectForKey, keyTwo));
+
+			release(dict);
+		}
+
+		dict = $((Dictionary *) alloc(Dictionary), initWithObjectsForKeysCount, NULL, NULL, 0);
+
+		ck_assert_int_eq(0, dict->count);
+		ck_assert_ptr_eq(NULL, $(dict, objectForKey, keyOne));
+
+		release(dict);
+
+		release(objects);
+		release(keys);
+
+		ck_assert_int_eq(1, objectOne->referenceCount);
+		ck_assert_int_eq(1, objectTwo->referenceCount);
+		ck_assert_int_eq(1, objectThree->referenceCount);
+
+		release(objectOne);
+		release(objectTwo);
+		release(objectThree);
+
+		release(keyOne);
+		release(keyTwo);
+
+	}END_TEST
+
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("dictionary");
 	tcase_add_test(tcase, dictionary);
+	tcase_add_test(tcase, objectsForKeys);
 
 	Suite *suite = suite_create("dictionary");
 	suite_add_tcase(suite, tcase);
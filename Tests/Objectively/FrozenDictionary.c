@@ -0,0 +1,190 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+
+#include <Objectively.h>
+
+static _Bool enumerator(const Dictionary *dictionary, ident obj, ident key, ident data) {
+
+	(* (int *) data)++; return false;
+}
+
+START_TEST(frozenDictionary)
+	{
+		MutableDictionary *mutable = $$(MutableDictionary, dictionary);
+
+		for (int i = 0; i < 10000; i++) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", i);
+			Number *number = $$(Number, numberWithValue, i);
+
+			$(mutable, setObjectForKey, number, key);
+
+			release(number);
+			release(key);
+		}
+
+		FrozenDictionary *dict = $$(FrozenDictionary, dictionaryWithDictionary, (Dictionary *) mutable);
+
+		ck_assert(dict != NULL);
+		ck_assert_ptr_eq(_FrozenDictionary(), classof(dict));
+
+		ck_assert_int_eq(10000, ((Dictionary *) dict)->count);
+
+		for (int i = 0; i < 20000; i++) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", i);
+			const Number *number = $((Dictionary *) dict, objectForKey, key);
+
+			if (i < 10000) {
+				ck_assert(number != NULL);
+				ck_assert_int_eq(i, $(number, intValue));
+			} else {
+				ck_assert_ptr_eq(NULL, number);
+			}
+
+			release(key);
+		}
+
+		int counter = 0;
+
+		$((Dictionary *) dict, enumerateObjectsAndKeys, enumerator, &counter);
+
+		ck_assert_int_eq(10000, counter);
+
+		DictionaryIterator iterator = $((Dictionary *) dict, iterator);
+		ident obj, key;
+
+		counter = 0;
+
+		while ($((Dictionary *) dict, nextObjectAndKey, &iterator, &obj, &key)) {
+			ck_assert_ptr_eq(obj, $((Dictionary *) dict, objectForKey, key));
+			counter++;
+		}
+
+		ck_assert_int_eq(10000, counter);
+
+		ck_assert($((Object *) dict, isEqual, (Object *) mutable));
+		ck_assert($((Object *) mutable, isEqual, (Object *) dict));
+		ck_assert_int_eq($((Object *) dict, hash), $((Object *) mutable, hash));
+
+		Dictionary *copy = (Dictionary *) $((Object *) dict, copy);
+
+		ck_assert_ptr_eq(_FrozenDictionary(), classof(copy));
+		ck_assert($((Object *) copy, isEqual, (Object *) dict));
+
+		Dictionary *thawed = $$(Dictionary, dictionaryWithDictionary, (Dictionary *) dict);
+
+		ck_assert_ptr_eq(_Dictionary(), classof(thawed));
+		ck_assert($((Object *) thawed, isEqual, (Object *) dict));
+
+		release(thawed);
+		release(copy);
+		release(dict);
+		release(mutable);
+
+		Object *object = $(alloc(Object), init);
+
+		dict = (FrozenDictionary *) $((Dictionary *) alloc(FrozenDictionary), initWithObjectsAndKeys,
+				object, $$(Number, numberWithValue, 1),
+				object, $$(Number, numberWithValue, 2), NULL);
+
+		ck_assert_int_eq(2, ((Dictionary *) dict)->count);
+		ck_assert_int_eq(3, object->referenceCount);
+
+		Number *two = $$(Number, numberWithValue, 2);
+		ck_assert_ptr_eq(object, $((Dictionary *) dict, objectForKey, two));
+		release(two);
+
+		release(dict);
+
+		ck_assert_int_eq(1, object->referenceCount);
+		release(object);
+
+		mutable = $$(MutableDictionary, dictionary);
+
+		for (int i = 0; i < 400; i++) {
+
+			Number *number = $$(Number, numberWithValue, i * 0.25);
+
+			$(mutable, setObjectForKey, number, number);
+
+			release(number);
+		}
+
+		dict = $$(FrozenDictionary, dictionaryWithDictionary, (Dictionary *) mutable);
+
+		ck_assert_int_eq(400, ((Dictionary *) dict)->count);
+		ck_assert_int_eq(300, dict->collisionCount);
+
+		for (int i = 0; i < 800; i++) {
+
+			Number *number = $$(Number, numberWithValue, i * 0.25);
+			const Number *found = $((Dictionary *) dict, objectForKey, number);
+
+			if (i < 400) {
+				ck_assert(found != NULL);
+				ck_assert($((Object *) found, isEqual, (Object *) number));
+			} else {
+				ck_assert_ptr_eq(NULL, found);
+			}
+
+			release(number);
+		}
+
+		ck_assert($((Object *) dict, isEqual, (Object *) mutable));
+
+		copy = (Dictionary *) $((Object *) dict, copy);
+		ck_assert($((Object *) copy, isEqual, (Object *) dict));
+
+		release(copy);
+		release(dict);
+		release(mutable);
+
+		dict = (FrozenDictionary *) $((Dictionary *) alloc(FrozenDictionary), initWithDictionary, NULL);
+
+		ck_assert_int_eq(0, ((Dictionary *) dict)->count);
+		ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForKey, object));
+
+		release(dict);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("frozenDictionary");
+	tcase_add_test(tcase, frozenDictionary);
+
+	Suite *suite = suite_create("frozenDictionary");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
@@ -0,0 +1,91 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+
+#include <Objectively.h>
+
+START_TEST(hashForBytes)
+	{
+		const char *chars = "the quick brown fox jumps over the lazy dog";
+
+		const Range fox = { 16, 3 };
+		const Range dog = { 40, 3 };
+
+		ck_assert_int_eq(HashForCString(HASH_SEED, "fox"), HashForCharacters(HASH_SEED, chars, fox));
+		ck_assert_int_eq(HashForCString(HASH_SEED, "dog"), HashForCharacters(HASH_SEED, chars, dog));
+		ck_assert_int_ne(HashForCharacters(HASH_SEED, chars, fox), HashForCharacters(HASH_SEED, chars, dog));
+
+		ck_assert_int_ne(HashForCString(HASH_SEED, chars), HashForCString(HASH_SEED + 1, chars));
+
+	}END_TEST
+
+START_TEST(hashForBytes64)
+	{
+		uint8_t bytes[256];
+		uint64_t hashes[lengthof(bytes) + 1];
+
+		for (size_t i = 0; i < lengthof(bytes); i++) {
+			bytes[i] = (uint8_t) i;
+		}
+
+		for (size_t i = 0; i <= lengthof(bytes); i++) {
+
+			hashes[i] = HashForBytes64(HASH_SEED, bytes, i);
+			ck_assert(hashes[i] == HashForBytes64(HASH_SEED, bytes, i));
+
+			for (size_t j = 0; j < i; j++) {
+				ck_assert(hashes[i] != hashes[j]);
+			}
+		}
+
+		for (size_t i = 0; i < lengthof(bytes); i++) {
+
+			bytes[i] ^= 1;
+			ck_assert(HashForBytes64(HASH_SEED, bytes, lengthof(bytes)) != hashes[lengthof(bytes)]);
+			bytes[i] ^= 1;
+		}
+
+		ck_assert(HashForBytes64(HASH_SEED, bytes, lengthof(bytes)) != HashForBytes64(HASH_SEED + 1, bytes, lengthof(bytes)));
+		ck_assert(HashSeed() == HashSeed());
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("hash");
+	tcase_add_test(tcase, hashForBytes);
+	tcase_add_test(tcase, hashForBytes64);
+
+	Suite *suite = suite_create("hash");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
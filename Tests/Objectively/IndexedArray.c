@@ -0,0 +1,210 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Objectively.h>
+
+/**
+ * @return The index of `obj` in `array`, found by linear scan.
+ */
+static ssize_t linearIndexOfObject(const Array *array, const ident obj) {
+
+	for (size_t i = 0; i < array->count; i++) {
+		if ($((Object *) obj, isEqual, (Object *) array->elements[i])) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Asserts that every key resolves to the same index as a linear scan would find.
+ */
+static void assertConsistent(const IndexedArray *array, String **keys, size_t count) {
+
+	for (size_t i = 0; i < count; i++) {
+		const ssize_t expected = linearIndexOfObject((Array *) array, keys[i]);
+		ck_assert_int_eq(expected, $((Array *) array, indexOfObject, keys[i]));
+		ck_assert_int_eq(expected != -1, $((Array *) array, containsObject, keys[i]));
+	}
+}
+
+static Order compareStrings(const ident a, const ident b) {
+	const int order = strcmp(((String *) a)->chars, ((String *) b)->chars);
+	return order < 0 ? OrderAscending : order > 0 ? OrderDescending : OrderSame;
+}
+
+START_TEST(indexedArray)
+	{
+		IndexedArray *array = $$(IndexedArray, array);
+
+		ck_assert(array != NULL);
+		ck_assert_ptr_eq(_IndexedArray(), classof(array));
+
+		String *one = str("one"), *two = str("two"), *three = str("three");
+
+		$((MutableArray *) array, addObject, one);
+		$((MutableArray *) array, addObject, two);
+
+		ck_assert(array->entries == NULL);
+
+		ck_assert_int_eq(0, $((Array *) array, indexOfObject, one));
+		ck_assert_int_eq(1, $((Array *) array, indexOfObject, two));
+		ck_assert_int_eq(-1, $((Array *) array, indexOfObject, three));
+
+		ck_assert(array->entries != NULL);
+
+		String *copy = (String *) $((Object *) one, copy);
+		ck_assert_int_eq(0, $((Array *) array, indexOfObject, copy));
+		release(copy);
+
+		$((MutableArray *) array, insertObjectAtIndex, three, 0);
+		ck_assert_int_eq(0, $((Array *) array, indexOfObject, three));
+		ck_assert_int_eq(1, $((Array *) array, indexOfObject, one));
+		ck_assert_int_eq(2, $((Array *) array, indexOfObject, two));
+
+		$((MutableArray *) array, addObject, three);
+		$((MutableArray *) array, removeObjectAtIndex, 0);
+		ck_assert_int_eq(2, $((Array *) array, indexOfObject, three));
+
+		$((MutableArray *) array, removeObject, three);
+		ck_assert(!$((Array *) array, containsObject, three));
+		ck_assert_int_eq(2, ((Array *) array)->count);
+
+		IndexedArray *that = (IndexedArray *) $((Object *) array, copy);
+		ck_assert_ptr_eq(_IndexedArray(), classof(that));
+		ck_assert($((Object *) array, isEqual, (Object *) that));
+		ck_assert_int_eq(1, $((Array *) that, indexOfObject, two));
+		release(that);
+
+		$((MutableArray *) array, setObjectAtIndex, three, 0);
+		ck_assert(array->entries != NULL);
+		ck_assert_int_eq(-1, $((Array *) array, indexOfObject, one));
+		ck_assert_int_eq(0, $((Array *) array, indexOfObject, three));
+
+		$((MutableArray *) array, setObjectAtIndex, two, 0);
+		ck_assert_int_eq(-1, $((Array *) array, indexOfObject, three));
+		ck_assert_int_eq(0, $((Array *) array, indexOfObject, two));
+
+		copy = (String *) $((Object *) two, copy);
+		$((MutableArray *) array, setObjectAtIndex, copy, 0);
+		ck_assert_int_eq(0, $((Array *) array, indexOfObject, two));
+		release(copy);
+
+		$((MutableArray *) array, setObjectAtIndex, one, 0);
+		ck_assert_int_eq(0, $((Array *) array, indexOfObject, one));
+		ck_assert_int_eq(1, $((Array *) array, indexOfObject, two));
+		ck_assert(array->entries != NULL);
+
+		release(one);
+		release(two);
+		release(three);
+		release(array);
+
+	}END_TEST
+
+START_TEST(consistency)
+	{
+		const size_t count = 64;
+
+		String *keys[count];
+		for (size_t i = 0; i < count; i++) {
+			keys[i] = $(alloc(String), initWithFormat, "%zu", i);
+		}
+
+		IndexedArray *array = $$(IndexedArray, array);
+		MutableArray *mutableArray = (MutableArray *) array;
+
+		srand(0);
+
+		for (int i = 0; i < 4096; i++) {
+
+			String *key = keys[rand() % count];
+			const size_t length = ((Array *) array)->count;
+
+			switch (rand() % 8) {
+				case 0:
+				case 1:
+					$(mutableArray, addObject, key);
+					break;
+				case 2:
+					if (length) {
+						$(mutableArray, insertObjectAtIndex, key, rand() % length);
+					}
+					break;
+				case 3:
+				case 4:
+					if (length) {
+						$(mutableArray, removeObjectAtIndex, rand() % length);
+					}
+					break;
+				case 5:
+					$(mutableArray, removeObject, key);
+					break;
+				case 6:
+					if (rand() % 16 == 0) {
+						$(mutableArray, sortStable, compareStrings);
+					} else if (length) {
+						$(mutableArray, setObjectAtIndex, key, rand() % length);
+					}
+					break;
+				case 7:
+					if (length > 256) {
+						$(mutableArray, removeObjectsInRange, (Range) { 0, length / 2 });
+					}
+					break;
+			}
+
+			assertConsistent(array, keys, count);
+		}
+
+		release(array);
+
+		for (size_t i = 0; i < count; i++) {
+			release(keys[i]);
+		}
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("indexedArray");
+	tcase_add_test(tcase, indexedArray);
+	tcase_add_test(tcase, consistency);
+
+	Suite *suite = suite_create("indexedArray");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
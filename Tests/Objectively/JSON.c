@@ -59,6 +59,26 @@ START_TEST(json)
 
 	}END_TEST
 
+START_TEST(ordered)
+	{
+		const char *json = "{\"zebra\": \"z\", \"apple\": \"a\", \"mango\": \"m\"}";
+
+		Data *data = $$(Data, dataWithBytes, (uint8_t *) json, strlen(json));
+
+		Dictionary *dict = $$(JSONSerialization, objectFromData, data, 0);
+		ck_assert_ptr_eq(_OrderedDictionary(), classof(dict));
+
+		release(data);
+		data = $$(JSONSerialization, dataFromObject, dict, 0);
+
+		ck_assert_int_eq(strlen(json), data->length);
+		ck_assert(memcmp(json, data->bytes, data->length) == 0);
+
+		release(data);
+		release(dict);
+
+	}END_TEST
+
 int main(int argc, char **argv) {
 
 	if (argc == 2) {
@@ -69,6 +89,7 @@ int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("json");
 	tcase_add_test(tcase, json);
+	tcase_add_test(tcase, ordered);
 
 	Suite *suite = suite_create("json");
 	suite_add_tcase(suite, tcase);
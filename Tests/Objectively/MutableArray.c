@@ -121,10 +121,207 @@ START_TEST(mutableArray)
 
 	}END_TEST
 
+START_TEST(capacity)
+	{
+		MutableArray *array = $$(MutableArray, array);
+
+		$(array, reserveCapacity, 1000);
+		ck_assert_int_eq(1000, array->capacity);
+
+		ident elements = ((Array *) array)->elements;
+
+		for (int i = 0; i < 1000; i++) {
+
+			Number *number = $$(Number, numberWithValue, i);
+
+			$(array, addObject, number);
+
+			release(number);
+		}
+
+		ck_assert_ptr_eq(elements, ((Array *) array)->elements);
+		ck_assert_int_eq(1000, array->capacity);
+
+		for (int i = 0; i < 1000; i++) {
+
+			Number *number = $$(Number, numberWithValue, -(i + 1));
+
+			$(array, insertObjectAtIndex, number, 0);
+
+			release(number);
+		}
+
+		ck_assert_int_eq(2000, ((Array *) array)->count);
+		ck_assert_int_ge(array->capacity, 2000);
+
+		for (int i = 0; i < 2000; i++) {
+			Number *number = $((Array *) array, objectAtIndex, i);
+			ck_assert_int_eq(i - 1000, $(number, intValue));
+		}
+
+		for (int i = 0; i < 1000; i++) {
+			$(array, removeObjectAtIndex, 500);
+		}
+
+		ck_assert_int_eq(1000, ((Array *) array)->count);
+		ck_assert_int_eq(-1000, $((Number *) $((Array *) array, firstObject), intValue));
+		ck_assert_int_eq(-501, $((Number *) $((Array *) array, objectAtIndex, 499), intValue));
+		ck_assert_int_eq(500, $((Number *) $((Array *) array, objectAtIndex, 500), intValue));
+		ck_assert_int_eq(999, $((Number *) $((Array *) array, lastObject), intValue));
+
+		$(array, shrinkToFit);
+		ck_assert_int_eq(1000, array->capacity);
+
+		$(array, removeAllObjects);
+		$(array, shrinkToFit);
+
+		ck_assert_int_eq(0, array->capacity);
+		ck_assert_ptr_eq(NULL, ((Array *) array)->elements);
+
+		release(array);
+
+	}END_TEST
+
+_Bool odd(const ident obj, ident data) {
+	return $((Number *) obj, intValue) & 1;
+}
+
+START_TEST(removal)
+	{
+		MutableArray *array = $$(MutableArray, array);
+
+		Number *number = $$(Number, numberWithValue, 0.5);
+
+		for (int i = 0; i < 100; i++) {
+
+			Number *n = $$(Number, numberWithValue, i);
+
+			$(array, addObject, n);
+			$(array, addObject, number);
+
+			release(n);
+		}
+
+		ck_assert_int_eq(101, ((Object *) number)->referenceCount);
+
+		$(array, removeObject, number);
+		$(array, filter, odd, NULL);
+
+		ck_assert_int_eq(50, ((Array *) array)->count);
+		ck_assert_int_eq(1, ((Object *) number)->referenceCount);
+
+		for (int i = 0; i < 50; i++) {
+			ck_assert_int_eq(i * 2 + 1, $((Number *) $((Array *) array, objectAtIndex, i), intValue));
+		}
+
+		size_t indexes[] = { 49, 0, 10, 11, 12, 30 };
+
+		IndexSet *indexSet = $(alloc(IndexSet), initWithIndexes, indexes, lengthof(indexes));
+
+		$(array, removeObjectsAtIndexes, indexSet);
+
+		release(indexSet);
+
+		ck_assert_int_eq(44, ((Array *) array)->count);
+		ck_assert_int_eq(3, $((Number *) $((Array *) array, firstObject), intValue));
+		ck_assert_int_eq(19, $((Number *) $((Array *) array, objectAtIndex, 8), intValue));
+		ck_assert_int_eq(27, $((Number *) $((Array *) array, objectAtIndex, 9), intValue));
+		ck_assert_int_eq(97, $((Number *) $((Array *) array, lastObject), intValue));
+
+		$(array, removeObjectsInRange, (Range) { 1, 42 });
+
+		ck_assert_int_eq(2, ((Array *) array)->count);
+		ck_assert_int_eq(3, $((Number *) $((Array *) array, firstObject), intValue));
+		ck_assert_int_eq(97, $((Number *) $((Array *) array, lastObject), intValue));
+
+		$(array, removeObjectsInRange, (Range) { 0, 2 });
+
+		ck_assert_int_eq(0, ((Array *) array)->count);
+
+		release(number);
+		release(array);
+
+	}END_TEST
+
+Order truncatedComparator(const ident obj1, const ident obj2) {
+
+	const int a = $((Number *) obj1, intValue) / 1000, b = $((Number *) obj2, intValue) / 1000;
+
+	return a < b ? OrderAscending : a > b ? OrderDescending : OrderSame;
+}
+
+START_TEST(sortStable)
+	{
+		MutableArray *array = $$(MutableArray, array);
+
+		static int values[100000], positions[100000];
+
+		for (int i = 0; i < 100000; i++) {
+			values[i] = i;
+		}
+
+		for (int i = 100000 - 1; i > 0; i--) {
+			const int j = rand() % (i + 1), value = values[i];
+			values[i] = values[j];
+			values[j] = value;
+		}
+
+		for (int i = 0; i < 100000; i++) {
+
+			Number *number = $$(Number, numberWithValue, values[i]);
+
+			$(array, addObject, number);
+			positions[values[i]] = i;
+
+			release(number);
+		}
+
+		MutableArray *stable = (MutableArray *) $((Object *) array, copy);
+		$(stable, sortStable, truncatedComparator);
+
+		for (size_t i = 1; i < ((Array *) stable)->count; i++) {
+
+			const ident a = $((Array *) stable, objectAtIndex, i - 1);
+			const ident b = $((Array *) stable, objectAtIndex, i);
+
+			const Order order = truncatedComparator(a, b);
+			ck_assert(order != OrderDescending);
+
+			if (order == OrderSame) {
+				ck_assert_int_lt(positions[$((Number *) a, intValue)], positions[$((Number *) b, intValue)]);
+			}
+		}
+
+		const size_t concurrencies[] = { 0, 2, 3, 5, 8 };
+
+		for (size_t i = 0; i < lengthof(concurrencies); i++) {
+
+			MutableArray *parallel = (MutableArray *) $((Object *) array, copy);
+			$(parallel, sortParallel, truncatedComparator, concurrencies[i]);
+
+			for (size_t j = 0; j < ((Array *) stable)->count; j++) {
+				ck_assert_ptr_eq(((Array *) stable)->elements[j], ((Array *) parallel)->elements[j]);
+			}
+
+			release(parallel);
+		}
+
+		Array *sorted = $((Array *) array, sortedArray, truncatedComparator);
+		ck_assert($((Object *) sorted, isEqual, (Object *) stable));
+
+		release(sorted);
+		release(stable);
+		release(array);
+
+	}END_TEST
+
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("mutableArray");
 	tcase_add_test(tcase, mutableArray);
+	tcase_add_test(tcase, capacity);
+	tcase_add_test(tcase, removal);
+	tcase_add_test(tcase, sortStable);
 
 	Suite *suite = suite_create("mutableArray");
 	suite_add_tcase(suite, tcase);
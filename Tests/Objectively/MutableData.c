@@ -54,6 +54,23 @@ START_TEST(mutableData)
 		ck_assert_int_eq(8192 + 128, data->data.length);
 		ck_assert_int_eq(1, data->data.bytes[data->data.length - 1]);
 
+		Data *copy = (Data *) $((Object *) data, copy);
+		ck_assert_int_eq($((Object *) copy, hash), $((Object *) data, hash));
+
+		$(data, setLength, 128);
+		ck_assert_int_ne($((Object *) copy, hash), $((Object *) data, hash));
+
+		$(data, appendBytes, (uint8_t *) copy->bytes + 128, 8192);
+		ck_assert_int_eq($((Object *) copy, hash), $((Object *) data, hash));
+
+		data->data.bytes[0]++;
+		ck_assert_int_ne($((Object *) copy, hash), $((Object *) data, hash));
+
+		data->data.bytes[0]--;
+		ck_assert_int_eq($((Object *) copy, hash), $((Object *) data, hash));
+
+		release(copy);
+
 		release(data);
 
 	}END_TEST
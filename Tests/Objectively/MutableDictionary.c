@@ -90,10 +90,46 @@ START_TEST(mutableDictionary)
 
 			release(object);
 			release(key);
+
+			if (i == 899) {
+				ck_assert(((Dictionary *) dict)->previousEntries != NULL);
+
+				Array *keys = $((Dictionary *) dict, allKeys);
+				ck_assert_int_eq(900, keys->count);
+				release(keys);
+
+				Dictionary *copy = $$(Dictionary, dictionaryWithDictionary, (Dictionary *) dict);
+				ck_assert($((Object *) copy, isEqual, (Object *) dict));
+				release(copy);
+			}
 		}
 
 		ck_assert_int_eq(1024, ((Dictionary *) dict)->count);
 
+		for (int i = 0; i < 1024; i += 2) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", i);
+
+			$(dict, removeObjectForKey, key);
+
+			release(key);
+		}
+
+		ck_assert_int_eq(512, ((Dictionary *) dict)->count);
+
+		for (int i = 0; i < 1024; i++) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", i);
+
+			if (i & 1) {
+				ck_assert($((Dictionary *) dict, objectForKey, key) != NULL);
+			} else {
+				ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForKey, key));
+			}
+
+			release(key);
+		}
+
 		$(dict, removeAllObjects);
 
 		ck_assert_int_eq(((Dictionary *) dict)->count, 0);
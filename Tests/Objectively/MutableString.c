@@ -52,6 +52,17 @@ START_TEST(string)
 		ck_assert_ptr_eq(_MutableString(), classof(copy));
 		ck_assert($((Object *) string, isEqual, (Object *) copy));
 
+		ck_assert_int_eq($((Object *) copy, hash), $((Object *) string, hash));
+
+		$(string, appendCharacters, "!");
+
+		String *expected = str("goodbye  cruel  world!!");
+		ck_assert_int_eq($((Object *) expected, hash), $((Object *) string, hash));
+		release(expected);
+
+		$(string, deleteCharactersInRange, (Range) { 22, 1 });
+		ck_assert_int_eq($((Object *) copy, hash), $((Object *) string, hash));
+
 		release(hello);
 		release(goodbye);
 		release(string);
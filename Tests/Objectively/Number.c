@@ -46,10 +46,38 @@ START_TEST(number)
 
 	}END_TEST
 
+START_TEST(numberWithValue)
+	{
+		Number *one = $$(Number, numberWithValue, 1.0);
+		ck_assert(one != NULL);
+		ck_assert_ptr_eq(one, $$(Number, numberWithValue, 1.0));
+
+		release(one);
+		release(one);
+		release(one);
+		ck_assert(1 == $(one, intValue));
+
+		Number *half = $$(Number, numberWithValue, 0.5);
+		Number *otherHalf = $$(Number, numberWithValue, 0.5);
+		ck_assert(half != otherHalf);
+		ck_assert_int_eq(1, half->object.referenceCount);
+
+		Number *zero = $$(Number, numberWithValue, 0.0);
+		Number *negativeZero = $$(Number, numberWithValue, -0.0);
+		ck_assert(zero != negativeZero);
+
+		release(half);
+		release(otherHalf);
+		release(zero);
+		release(negativeZero);
+
+	}END_TEST
+
 int main(int argc, char **argv) {
 
 	TCase *tcase = tcase_create("number");
 	tcase_add_test(tcase, number);
+	tcase_add_test(tcase, numberWithValue);
 
 	Suite *suite = suite_create("number");
 	suite_add_tcase(suite, tcase);
@@ -0,0 +1,180 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+
+#include <Objectively.h>
+
+static _Bool filter(const Dictionary *dictionary, ident obj, ident key, ident data) {
+
+	return ((Number *) obj)->value >= 500;
+}
+
+/**
+ * @brief Asserts that `dict` iterates the Numbers `first, first + step, ...` in order.
+ */
+static void assertOrder(const Dictionary *dict, int first, int step) {
+
+	DictionaryIterator iterator = $(dict, iterator);
+	ident obj, key;
+
+	int expected = first;
+
+	while ($(dict, nextObjectAndKey, &iterator, &obj, &key)) {
+
+		ck_assert_int_eq(expected, $((Number *) obj, intValue));
+		ck_assert_ptr_eq(obj, $(dict, objectForKey, key));
+
+		expected += step;
+	}
+
+	ck_assert_int_eq(first + step * (int) dict->count, expected);
+}
+
+START_TEST(orderedDictionary)
+	{
+		OrderedDictionary *dict = $$(OrderedDictionary, dictionary);
+
+		ck_assert(dict != NULL);
+		ck_assert_ptr_eq(_OrderedDictionary(), classof(dict));
+		ck_assert($((Object *) dict, isKindOfClass, _MutableDictionary()));
+
+		for (int i = 0; i < 1000; i++) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", 999 - i);
+			Number *number = $$(Number, numberWithValue, i);
+
+			$((MutableDictionary *) dict, setObjectForKey, number, key);
+
+			release(number);
+			release(key);
+		}
+
+		ck_assert_int_eq(1000, ((Dictionary *) dict)->count);
+
+		assertOrder((Dictionary *) dict, 0, 1);
+
+		for (int i = 0; i < 1000; i += 2) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", 999 - i);
+
+			$((MutableDictionary *) dict, removeObjectForKey, key);
+
+			release(key);
+		}
+
+		ck_assert_int_eq(500, ((Dictionary *) dict)->count);
+
+		assertOrder((Dictionary *) dict, 1, 2);
+
+		for (int i = 0; i < 1000; i++) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", 999 - i);
+
+			if (i & 1) {
+				ck_assert($((Dictionary *) dict, objectForKey, key) != NULL);
+			} else {
+				ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForKey, key));
+			}
+
+			release(key);
+		}
+
+		Dictionary *filtered = $((Dictionary *) dict, filterObjectsAndKeys, filter, NULL);
+
+		ck_assert_ptr_eq(_OrderedDictionary(), classof(filtered));
+		ck_assert_int_eq(250, filtered->count);
+
+		assertOrder(filtered, 501, 2);
+
+		release(filtered);
+
+		Dictionary *copy = (Dictionary *) $((Object *) dict, copy);
+
+		ck_assert_ptr_eq(_OrderedDictionary(), classof(copy));
+		ck_assert($((Object *) copy, isEqual, (Object *) dict));
+
+		assertOrder(copy, 1, 2);
+
+		release(copy);
+
+		String *key = str("998");
+		Number *number = $$(Number, numberWithValue, 1);
+
+		$((MutableDictionary *) dict, setObjectForKey, number, key);
+
+		ck_assert_int_eq(500, ((Dictionary *) dict)->count);
+		assertOrder((Dictionary *) dict, 1, 2);
+
+		$((MutableDictionary *) dict, removeObjectForKey, key);
+
+		release(number);
+		number = $$(Number, numberWithValue, 1001);
+
+		$((MutableDictionary *) dict, setObjectForKey, number, key);
+
+		ck_assert_int_eq(500, ((Dictionary *) dict)->count);
+		assertOrder((Dictionary *) dict, 3, 2);
+
+		release(number);
+		release(key);
+
+		$((MutableDictionary *) dict, removeAllObjects);
+
+		ck_assert_int_eq(0, ((Dictionary *) dict)->count);
+
+		release(dict);
+
+		Object *object = $(alloc(Object), init);
+
+		dict = (OrderedDictionary *) $((Dictionary *) alloc(OrderedDictionary), initWithObjectsAndKeys,
+				object, $$(Number, numberWithValue, 1),
+				object, $$(Number, numberWithValue, 2), NULL);
+
+		ck_assert_int_eq(2, ((Dictionary *) dict)->count);
+		ck_assert_int_eq(3, object->referenceCount);
+
+		release(dict);
+
+		ck_assert_int_eq(1, object->referenceCount);
+		release(object);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("orderedDictionary");
+	tcase_add_test(tcase, orderedDictionary);
+
+	Suite *suite = suite_create("orderedDictionary");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
@@ -0,0 +1,228 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+
+#include <Objectively.h>
+
+static _Bool enumerator(const Dictionary *dictionary, ident obj, ident key, ident data) {
+
+	(* (int *) data)++; return false;
+}
+
+START_TEST(persistentDictionary)
+	{
+		PersistentDictionary *dict = $(alloc(PersistentDictionary), init);
+
+		ck_assert(dict != NULL);
+		ck_assert_ptr_eq(_PersistentDictionary(), classof(dict));
+		ck_assert_int_eq(0, ((Dictionary *) dict)->count);
+
+		PersistentDictionary *snapshot = NULL;
+
+		for (int i = 0; i < 10000; i++) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", i);
+			Number *number = $$(Number, numberWithValue, i);
+
+			PersistentDictionary *next = $(dict, dictionaryBySettingObjectForKey, number, key);
+
+			release(number);
+			release(key);
+
+			release(dict);
+			dict = next;
+
+			if (i == 4999) {
+				snapshot = retain(dict);
+			}
+		}
+
+		ck_assert_int_eq(10000, ((Dictionary *) dict)->count);
+		ck_assert_int_eq(5000, ((Dictionary *) snapshot)->count);
+
+		for (int i = 0; i < 20000; i++) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", i);
+
+			const Number *number = $((Dictionary *) dict, objectForKey, key);
+			if (i < 10000) {
+				ck_assert(number != NULL);
+				ck_assert_int_eq(i, $(number, intValue));
+			} else {
+				ck_assert_ptr_eq(NULL, number);
+			}
+
+			number = $((Dictionary *) snapshot, objectForKey, key);
+			if (i < 5000) {
+				ck_assert(number != NULL);
+				ck_assert_int_eq(i, $(number, intValue));
+			} else {
+				ck_assert_ptr_eq(NULL, number);
+			}
+
+			release(key);
+		}
+
+		int counter = 0;
+
+		$((Dictionary *) dict, enumerateObjectsAndKeys, enumerator, &counter);
+
+		ck_assert_int_eq(10000, counter);
+
+		DictionaryIterator iterator = $((Dictionary *) dict, iterator);
+		ident obj, key;
+
+		counter = 0;
+
+		while ($((Dictionary *) dict, nextObjectAndKey, &iterator, &obj, &key)) {
+			ck_assert_ptr_eq(obj, $((Dictionary *) dict, objectForKey, key));
+			counter++;
+		}
+
+		ck_assert_int_eq(10000, counter);
+
+		Dictionary *thawed = $$(Dictionary, dictionaryWithDictionary, (Dictionary *) dict);
+
+		ck_assert($((Object *) dict, isEqual, (Object *) thawed));
+		ck_assert($((Object *) thawed, isEqual, (Object *) dict));
+		ck_assert_int_eq($((Object *) dict, hash), $((Object *) thawed, hash));
+
+		PersistentDictionary *copy = (PersistentDictionary *) $((Object *) dict, copy);
+
+		ck_assert_ptr_eq(_PersistentDictionary(), classof(copy));
+		ck_assert_ptr_eq(dict->root, copy->root);
+
+		release(copy);
+
+		copy = (PersistentDictionary *) $((Dictionary *) alloc(PersistentDictionary), initWithDictionary, thawed);
+
+		ck_assert($((Object *) copy, isEqual, (Object *) dict));
+
+		release(copy);
+		release(thawed);
+
+		for (int i = 0; i < 10000; i += 2) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", i);
+
+			PersistentDictionary *next = $(dict, dictionaryByRemovingObjectForKey, key);
+
+			release(key);
+			release(dict);
+
+			dict = next;
+		}
+
+		ck_assert_int_eq(5000, ((Dictionary *) dict)->count);
+		ck_assert_int_eq(5000, ((Dictionary *) snapshot)->count);
+
+		for (int i = 0; i < 10000; i++) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", i);
+
+			if (i & 1) {
+				ck_assert($((Dictionary *) dict, objectForKey, key) != NULL);
+			} else {
+				ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForKey, key));
+			}
+
+			if (i < 5000) {
+				ck_assert($((Dictionary *) snapshot, objectForKey, key) != NULL);
+			}
+
+			release(key);
+		}
+
+		String *missing = str("missing");
+		PersistentDictionary *same = $(dict, dictionaryByRemovingObjectForKey, missing);
+
+		ck_assert_ptr_eq(dict->root, same->root);
+		ck_assert_int_eq(5000, ((Dictionary *) same)->count);
+
+		release(same);
+		release(missing);
+
+		for (int i = 1; i < 10000; i += 2) {
+
+			String *key = $(alloc(String), initWithFormat, "%d", i);
+
+			PersistentDictionary *next = $(dict, dictionaryByRemovingObjectForKey, key);
+
+			release(key);
+			release(dict);
+
+			dict = next;
+		}
+
+		ck_assert_int_eq(0, ((Dictionary *) dict)->count);
+		ck_assert_ptr_eq(NULL, dict->root);
+
+		release(dict);
+		release(snapshot);
+
+		Object *object = $(alloc(Object), init);
+
+		dict = (PersistentDictionary *) $((Dictionary *) alloc(PersistentDictionary), initWithObjectsAndKeys,
+				object, $$(Number, numberWithValue, 1),
+				object, $$(Number, numberWithValue, 2), NULL);
+
+		ck_assert_int_eq(2, ((Dictionary *) dict)->count);
+		ck_assert_int_eq(3, object->referenceCount);
+
+		Number *two = $$(Number, numberWithValue, 2);
+		ck_assert_ptr_eq(object, $((Dictionary *) dict, objectForKey, two));
+
+		PersistentDictionary *removed = $(dict, dictionaryByRemovingObjectForKey, two);
+
+		ck_assert_int_eq(1, ((Dictionary *) removed)->count);
+		ck_assert_ptr_eq(NULL, $((Dictionary *) removed, objectForKey, two));
+		ck_assert_ptr_eq(object, $((Dictionary *) dict, objectForKey, two));
+		ck_assert_int_eq(4, object->referenceCount);
+
+		release(removed);
+		release(two);
+		release(dict);
+
+		ck_assert_int_eq(1, object->referenceCount);
+		release(object);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("persistentDictionary");
+	tcase_add_test(tcase, persistentDictionary);
+
+	Suite *suite = suite_create("persistentDictionary");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
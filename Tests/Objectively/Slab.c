@@ -0,0 +1,185 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include <Objectively.h>
+
+#define _Class _Counted
+
+static Class *_Counted(void);
+
+static int deallocations;
+
+static void countDeallocation(Object *self) {
+
+	__sync_add_and_fetch(&deallocations, 1);
+
+	super(Object, self, dealloc);
+}
+
+static void initializeCounted(Class *clazz) {
+	((ObjectInterface *) clazz->def->interface)->dealloc = countDeallocation;
+}
+
+/**
+ * @brief A Class whose deallocations are counted.
+ */
+static Class *_Counted(void) {
+	static Class clazz;
+	static Once once;
+
+	do_once(&once, {
+		clazz.name = "Counted";
+		clazz.superclass = _Object();
+		clazz.instanceSize = sizeof(Object);
+		clazz.interfaceOffset = offsetof(Object, interface);
+		clazz.interfaceSize = sizeof(ObjectInterface);
+		clazz.initialize = initializeCounted;
+	});
+
+	return &clazz;
+}
+
+#undef _Class
+
+#define OBJECTS (SLAB_MAGAZINE_SIZE * 3)
+
+static Object *objects[OBJECTS];
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
+static int stage;
+
+/**
+ * @brief Advances the stage, and waits for the other thread to advance it again.
+ */
+static void handoff(void) {
+
+	pthread_mutex_lock(&lock);
+
+	const int next = ++stage + 1;
+	pthread_cond_broadcast(&cond);
+
+	while (stage < next) {
+		pthread_cond_wait(&cond, &lock);
+	}
+
+	pthread_mutex_unlock(&lock);
+}
+
+/**
+ * @brief Allocates the Objects, and exits once they have been released by another thread, so that
+ * their deallocation is deferred to this thread's destructors.
+ */
+static ident allocObjects(ident data) {
+
+	for (size_t i = 0; i < OBJECTS; i++) {
+		objects[i] = _alloc(_Counted());
+	}
+
+	handoff();
+
+	return NULL;
+}
+
+START_TEST(slab)
+	{
+		Slab *slab = SlabCreate(24);
+		ck_assert(slab != NULL);
+
+		ident blocks[SLAB_MAGAZINE_SIZE * 3];
+
+		for (size_t i = 0; i < lengthof(blocks); i++) {
+			blocks[i] = SlabAllocate(slab);
+			ck_assert(blocks[i] != NULL);
+			ck_assert_int_eq(0, ((uintptr_t) blocks[i]) & 15);
+		}
+
+		for (size_t i = 0; i < lengthof(blocks); i++) {
+			SlabFree(slab, blocks[i]);
+		}
+
+		for (size_t i = 0; i < lengthof(blocks); i++) {
+			blocks[i] = SlabAllocate(slab);
+			ck_assert(blocks[i] != NULL);
+		}
+
+		SlabDestroy(slab);
+
+	}END_TEST
+
+START_TEST(threadExit)
+	{
+		pthread_t thread;
+
+		deallocations = 0;
+		stage = 0;
+
+		pthread_create(&thread, NULL, allocObjects, NULL);
+
+		pthread_mutex_lock(&lock);
+		while (stage < 1) {
+			pthread_cond_wait(&cond, &lock);
+		}
+		pthread_mutex_unlock(&lock);
+
+		for (size_t i = 0; i < OBJECTS; i++) {
+			release(objects[i]);
+		}
+
+		ck_assert_int_eq(0, deallocations);
+
+		pthread_mutex_lock(&lock);
+		stage++;
+		pthread_cond_broadcast(&cond);
+		pthread_mutex_unlock(&lock);
+
+		pthread_join(thread, NULL);
+
+		ck_assert_int_eq(OBJECTS, deallocations);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	setenv("OBJECTIVELY_SLAB", "1", 1);
+
+	TCase *tcase = tcase_create("slab");
+	tcase_add_test(tcase, slab);
+	tcase_add_test(tcase, threadExit);
+
+	Suite *suite = suite_create("slab");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}
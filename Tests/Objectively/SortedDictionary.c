@@ -0,0 +1,371 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+
+#include <Objectively.h>
+
+static Order compareNumbers(const ident obj1, const ident obj2) {
+	return $((Number *) obj1, compareTo, (Number *) obj2);
+}
+
+static Number *number(int value) {
+	return $$(Number, numberWithValue, value);
+}
+
+static _Bool sum(const Dictionary *dict, ident obj, ident key, ident data) {
+	*(int *) data += ((Number *) key)->value; return false;
+}
+
+START_TEST(sortedDictionary)
+	{
+		SortedDictionary *dict = $$(SortedDictionary, dictionaryWithComparator, compareNumbers);
+
+		ck_assert(dict != NULL);
+		ck_assert_ptr_eq(_SortedDictionary(), classof(dict));
+
+		for (int i = 0; i < 4096; i++) {
+
+			Number *key = number((i * 37) % 4096);
+
+			$((MutableDictionary *) dict, setObjectForKey, key, key);
+
+			release(key);
+		}
+
+		ck_assert_int_eq(4096, ((Dictionary *) dict)->count);
+
+		Number *key = number(100);
+		Number *obj = $((Dictionary *) dict, objectForKey, key);
+
+		ck_assert(obj != NULL);
+		release(key);
+
+		Number *previous = NULL;
+		ident k;
+
+		DictionaryIterator iterator = $((Dictionary *) dict, iterator);
+		for (int i = 0; $((Dictionary *) dict, nextObjectAndKey, &iterator, NULL, &k); i++) {
+			ck_assert_int_eq(i, ((Number *) k)->value);
+			if (previous) {
+				ck_assert_int_eq(OrderAscending, compareNumbers(previous, k));
+			}
+			previous = k;
+		}
+
+		for (int i = 0; i < 4096; i += 2) {
+
+			key = number(i);
+
+			$((MutableDictionary *) dict, removeObjectForKey, key);
+
+			release(key);
+		}
+
+		ck_assert_int_eq(2048, ((Dictionary *) dict)->count);
+
+		for (int i = 0; i < 4096; i++) {
+
+			key = number(i);
+
+			if (i & 1) {
+				ck_assert($((Dictionary *) dict, objectForKey, key) != NULL);
+			} else {
+				ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForKey, key));
+			}
+
+			release(key);
+		}
+
+		Dictionary *copy = (Dictionary *) $((Object *) dict, copy);
+
+		ck_assert_ptr_eq(_SortedDictionary(), classof(copy));
+		ck_assert($((Object *) copy, isEqual, (Object *) dict));
+		release(copy);
+
+		for (int i = 4095; i >= 0; i -= 2) {
+
+			key = number(i);
+
+			$((MutableDictionary *) dict, removeObjectForKey, key);
+
+			release(key);
+		}
+
+		ck_assert_int_eq(0, ((Dictionary *) dict)->count);
+		ck_assert_ptr_eq(NULL, dict->root);
+		ck_assert_ptr_eq(NULL, dict->first);
+
+		release(dict);
+
+	}END_TEST
+
+START_TEST(range)
+	{
+		SortedDictionary *dict = $$(SortedDictionary, dictionaryWithComparator, compareNumbers);
+
+		for (int i = 0; i < 1000; i += 10) {
+
+			Number *key = number(i);
+
+			$((MutableDictionary *) dict, setObjectForKey, key, key);
+
+			release(key);
+		}
+
+		Number *from = number(95), *to = number(205);
+
+		Array *objects = $(dict, objectsInRange, from, to);
+
+		ck_assert_int_eq(11, objects->count);
+		ck_assert_int_eq(100, ((Number *) $(objects, firstObject))->value);
+		ck_assert_int_eq(200, ((Number *) $(objects, lastObject))->value);
+
+		release(objects);
+
+		ck_assert_int_eq(90, ((Number *) $(dict, floorKey, from))->value);
+		ck_assert_int_eq(100, ((Number *) $(dict, ceilingKey, from))->value);
+
+		release(from);
+		release(to);
+
+		from = number(100);
+		to = number(200);
+
+		objects = $(dict, objectsInRange, from, to);
+
+		ck_assert_int_eq(10, objects->count);
+		ck_assert_int_eq(100, ((Number *) $(objects, firstObject))->value);
+		ck_assert_int_eq(190, ((Number *) $(objects, lastObject))->value);
+
+		release(objects);
+
+		ck_assert_int_eq(100, ((Number *) $(dict, floorKey, from))->value);
+		ck_assert_int_eq(100, ((Number *) $(dict, ceilingKey, from))->value);
+
+		int total = 0;
+		$(dict, enumerateObjectsAndKeysInRange, NULL, from, sum, &total);
+		ck_assert_int_eq(450, total);
+
+		release(from);
+		release(to);
+
+		from = number(-1);
+		to = number(991);
+
+		ck_assert_ptr_eq(NULL, $(dict, floorKey, from));
+		ck_assert_int_eq(0, ((Number *) $(dict, ceilingKey, from))->value);
+		ck_assert_int_eq(990, ((Number *) $(dict, floorKey, to))->value);
+		ck_assert_ptr_eq(NULL, $(dict, ceilingKey, to));
+
+		objects = $(dict, objectsInRange, to, NULL);
+		ck_assert_int_eq(0, objects->count);
+		release(objects);
+
+		objects = $(dict, objectsInRange, NULL, NULL);
+		ck_assert_int_eq(100, objects->count);
+		release(objects);
+
+		release(from);
+		release(to);
+
+		release(dict);
+
+	}END_TEST
+
+START_TEST(sortedObjectsForKeys)
+	{
+		MutableArray *keys = $$(MutableArray, array);
+
+		for (int i = 0; i < 10000; i++) {
+
+			Number *key = number(i);
+
+			$(keys, addObject, key);
+
+			release(key);
+		}
+
+		SortedDictionary *dict = $(alloc(SortedDictionary), initWithSortedObjectsForKeys, compareNumbers,
+				(Array *) keys, (Array *) keys);
+
+		ck_assert_int_eq(10000, ((Dictionary *) dict)->count);
+
+		for (int i = 0; i < 10000; i++) {
+			Number *key = $((Array *) keys, objectAtIndex, i);
+			ck_assert_ptr_eq(key, $((Dictionary *) dict, objectForKey, key));
+		}
+
+		int total = 0;
+		$((Dictionary *) dict, enumerateObjectsAndKeys, sum, &total);
+		ck_assert_int_eq(49995000, total);
+
+		Number *key = number(10000);
+
+		$((MutableDictionary *) dict, setObjectForKey, key, key);
+		ck_assert_int_eq(10001, ((Dictionary *) dict)->count);
+
+		release(key);
+
+		Dictionary *copy = $$(Dictionary, dictionaryWithDictionary, (Dictionary *) dict);
+		ck_assert_ptr_eq(_Dictionary(), classof(copy));
+		ck_assert($((Object *) copy, isEqual, (Object *) dict));
+
+		SortedDictionary *sorted = $(alloc(SortedDictionary), initWithComparator, compareNumbers);
+		$((MutableDictionary *) sorted, addEntriesFromDictionary, copy);
+		ck_assert($((Object *) sorted, isEqual, (Object *) dict));
+
+		release(sorted);
+		release(copy);
+
+		release(dict);
+		release(keys);
+
+	}END_TEST
+
+START_TEST(initializers)
+	{
+		ck_assert_ptr_eq(NULL, $((MutableDictionary *) alloc(SortedDictionary), init));
+		ck_assert_ptr_eq(NULL, $((MutableDictionary *) alloc(SortedDictionary), initWithCapacity, 8));
+		ck_assert_ptr_eq(NULL, $(alloc(SortedDictionary), initWithComparator, NULL));
+
+		Number *one = number(1);
+
+		ck_assert_ptr_eq(NULL, $((Dictionary *) alloc(SortedDictionary), initWithObjectsAndKeys, one, one, NULL));
+
+		Dictionary *dict = $$(Dictionary, dictionaryWithObjectsAndKeys, one, one, NULL);
+		ck_assert_ptr_eq(NULL, $((Dictionary *) alloc(SortedDictionary), initWithDictionary, dict));
+
+		SortedDictionary *sorted = $$(SortedDictionary, dictionaryWithComparator, compareNumbers);
+		$((MutableDictionary *) sorted, setObjectForKey, one, one);
+
+		SortedDictionary *copy = (SortedDictionary *) $((Dictionary *) alloc(SortedDictionary), initWithDictionary,
+				(Dictionary *) sorted);
+		ck_assert_ptr_eq(compareNumbers, copy->comparator);
+		ck_assert($((Object *) copy, isEqual, (Object *) sorted));
+
+		release(copy);
+		release(sorted);
+		release(dict);
+		release(one);
+
+	}END_TEST
+
+START_TEST(removal)
+	{
+		SortedDictionary *dict = $$(SortedDictionary, dictionaryWithComparator, compareNumbers);
+
+		for (int i = 0; i < 10000; i++) {
+
+			Number *key = number((i * 7919) % 10000);
+
+			$((MutableDictionary *) dict, setObjectForKey, key, key);
+
+			release(key);
+		}
+
+		int expected = 0;
+
+		for (int i = 0; i < 10000; i++) {
+
+			const int value = (i * 4001) % 10000;
+
+			if (value % 16) {
+				Number *key = number(value);
+
+				$((MutableDictionary *) dict, removeObjectForKey, key);
+
+				release(key);
+			} else {
+				expected += value;
+			}
+		}
+
+		ck_assert_int_eq(625, ((Dictionary *) dict)->count);
+
+		int total = 0;
+		$((Dictionary *) dict, enumerateObjectsAndKeys, sum, &total);
+		ck_assert_int_eq(expected, total);
+
+		for (int i = 0; i < 10000; i++) {
+
+			Number *key = number(i);
+
+			if (i % 16) {
+				ck_assert_ptr_eq(NULL, $((Dictionary *) dict, objectForKey, key));
+
+				Number *floor = $(dict, floorKey, key);
+				ck_assert_int_eq(i & ~15, floor->value);
+
+				Number *ceiling = $(dict, ceilingKey, key);
+				if (i < 9984) {
+					ck_assert_int_eq((i | 15) + 1, ceiling->value);
+				} else {
+					ck_assert_ptr_eq(NULL, ceiling);
+				}
+			} else {
+				const Object *obj = $((Dictionary *) dict, objectForKey, key);
+				ck_assert($((Object *) key, isEqual, obj));
+			}
+
+			release(key);
+		}
+
+		for (int i = 0; i < 10000; i += 16) {
+
+			Number *key = number(i);
+
+			$((MutableDictionary *) dict, removeObjectForKey, key);
+
+			release(key);
+		}
+
+		ck_assert_int_eq(0, ((Dictionary *) dict)->count);
+		ck_assert_ptr_eq(NULL, dict->root);
+		ck_assert_ptr_eq(NULL, dict->first);
+
+		release(dict);
+
+	}END_TEST
+
+int main(int argc, char **argv) {
+
+	TCase *tcase = tcase_create("sortedDictionary");
+	tcase_add_test(tcase, sortedDictionary);
+	tcase_add_test(tcase, range);
+	tcase_add_test(tcase, sortedObjectsForKeys);
+	tcase_add_test(tcase, initializers);
+	tcase_add_test(tcase, removal);
+
+	Suite *suite = suite_create("sortedDictionary");
+	suite_add_tcase(suite, tcase);
+
+	SRunner *runner = srunner_create(suite);
+
+	srunner_run_all(runner, CK_VERBOSE);
+	int failed = srunner_ntests_failed(runner);
+
+	srunner_free(runner);
+
+	return failed;
+}